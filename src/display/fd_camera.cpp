@@ -1,38 +1,10 @@
 #include "fd_camera.hpp"
 
-FD_Camera::FD_Camera(int w, int culling_radius) : FD_Resizable() {
-	this->x = new FD_Tween(0);
-	this->y = new FD_Tween(0);
-	this->w = new FD_Tween(w);
-	this->angle = new FD_Tween(0);
-	this->scale = new FD_Tween(1);
+FD_Camera::FD_Camera(int w, int culling_radius) : FD_Resizable(),
+	x{ 0 }, y{ 0 }, w{ static_cast<double>(w) }, scale{ 1 }, angle{ 0 } {
 	this->culling_radius = culling_radius;
-
-	random_x = new FD_RandomGenerator();
-	random_y = new FD_RandomGenerator();
-	random_angle = new FD_RandomGenerator();
-
-	culling_rect = new SDL_Rect();
-	bounds = new SDL_Rect();
-	bounding_rect = new SDL_Rect();
-	bounds_center = new SDL_Point();
-}
-FD_Camera::~FD_Camera() {
-	delete x;
-	delete y;
-	delete w;
-	delete scale;
-	delete angle;
-	delete bounds;
-
-	delete random_x;
-	delete random_y;
-	delete random_angle;
-
-	delete culling_rect;
-	delete bounding_rect;
-	delete bounds_center;
 }
+FD_Camera::~FD_Camera() {}
 void FD_Camera::associate(std::weak_ptr<FD_Window> window) {
 	std::shared_ptr<FD_Window> win;
 	FD_Handling::lock(window, win, true);
@@ -42,22 +14,22 @@ void FD_Camera::associate(std::weak_ptr<FD_Window> window) {
 
 void FD_Camera::update(bool force) {
 	// Update our bounds if needed
-	bool xm = x->moved();
-	bool ym = y->moved();
-	if (force || xm || ym || w->moved() || scale->moved()) {
-		bounds_center->x = static_cast<int>(x->value());
-		bounds_center->y = static_cast<int>(y->value());
-		bounds->w = static_cast<int>(w->value() * scale->value());
-		bounds->h = static_cast<int>(w->value() * scale->value() * aspect_ratio);
-		bounds->x = static_cast<int>(bounds_center->x - bounds->w / 2);
-		bounds->y = static_cast<int>(bounds_center->y - bounds->h / 2);
-		drawing_scale = resolution_width / (w->value() * scale->value());
+	bool xm = x.moved();
+	bool ym = y.moved();
+	if (force || xm || ym || w.moved() || scale.moved()) {
+		bounds_center.x = static_cast<int>(x.value());
+		bounds_center.y = static_cast<int>(y.value());
+		bounds.w = static_cast<int>(w.value() * scale.value());
+		bounds.h = static_cast<int>(w.value() * scale.value() * aspect_ratio);
+		bounds.x = static_cast<int>(bounds_center.x - bounds.w / 2);
+		bounds.y = static_cast<int>(bounds_center.y - bounds.h / 2);
+		drawing_scale = resolution_width / (w.value() * scale.value());
 		
-		max_x_shake = bounds->w * 0.01;
-		max_y_shake = bounds->h * 0.01;
+		max_x_shake = bounds.w * 0.01;
+		max_y_shake = bounds.h * 0.01;
 	} else if (xm || ym) {
-		bounds->x = static_cast<int>(x->value() - bounds->w / 2);
-		bounds->y = static_cast<int>(y->value() - bounds->h / 2);
+		bounds.x = static_cast<int>(x.value() - bounds.w / 2);
+		bounds.y = static_cast<int>(y.value() - bounds.h / 2);
 	}
 	shake_amount = shake_decrement(shake_amount);
 	if (shake_amount < 0.01) shake_amount = 0;
@@ -72,61 +44,62 @@ void FD_Camera::resized(int width, int height) {
 }
 
 void FD_Camera::pre_render() {
-	bounding_rect->w = getRotatedWidth();
-	bounding_rect->h = getRotatedHeight();
-	bounding_rect->x = static_cast<int>(
-		bounds_center->x - bounding_rect->w / 2.0);
-	bounding_rect->y = static_cast<int>(
-		bounds_center->y - bounding_rect->h / 2.0);
-	culling_rect->x = bounding_rect->x - culling_radius;
-	culling_rect->y = bounding_rect->y - culling_radius;
-	culling_rect->w = bounding_rect->w + (culling_radius << 1);
-	culling_rect->h = bounding_rect->h + (culling_radius << 1);
+	bounding_rect.w = getRotatedWidth();
+	bounding_rect.h = getRotatedHeight();
+	bounding_rect.x = static_cast<int>(
+		bounds_center.x - bounding_rect.w / 2.0);
+	bounding_rect.y = static_cast<int>(
+		bounds_center.y - bounding_rect.h / 2.0);
+	culling_rect.x = bounding_rect.x - culling_radius;
+	culling_rect.y = bounding_rect.y - culling_radius;
+	culling_rect.w = bounding_rect.w + (culling_radius << 1);
+	culling_rect.h = bounding_rect.h + (culling_radius << 1);
+	// Shake and rotate the same way for every object this frame
+	view_x = bounds_center.x + max_x_shake * shake_amount * random_x.getNoise();
+	view_y = bounds_center.y + max_y_shake * shake_amount * random_y.getNoise();
+	double a{ angle.value() + max_angle_shake * shake_amount * random_angle.getNoise() };
+	view_cos = std::cos(a * FD_PI / 180.0);
+	view_sin = std::sin(a * FD_PI / 180.0);
+}
+// Moves a rectangle relative to the shaken center, rotates it about the center and, scales it to the window
+void FD_Camera::transform(SDL_Rect& dstrect) const {
+	double center_x{ dstrect.x + dstrect.w / 2.0 - view_x };
+	double center_y{ dstrect.y + dstrect.h / 2.0 - view_y };
+	int x{ static_cast<int>(center_x * view_cos - center_y * view_sin) };
+	int y{ static_cast<int>(center_x * view_sin + center_y * view_cos) };
+	// Make relative to the screen
+	x += bounds.w / 2 - dstrect.w / 2;
+	y += bounds.h / 2 - dstrect.h / 2;
+	dstrect.x = static_cast<int>(x * drawing_scale);
+	dstrect.y = static_cast<int>(y * drawing_scale);
+	dstrect.w = static_cast<int>(dstrect.w * drawing_scale);
+	dstrect.h = static_cast<int>(dstrect.h * drawing_scale);
 }
 bool FD_Camera::manipulate(SDL_Rect& dstrect, double& angle) const {
-	if (!SDL_HasIntersection(culling_rect, &dstrect)) {
-		if (!SDL_RectEmpty(&dstrect)) {
-			bool outside{ true };
-			SDL_Point p{ dstrect.x, dstrect.y };
-			if (SDL_PointInRect(&p, culling_rect)) outside = false;
-			p.x = dstrect.x + dstrect.w;
-			if (SDL_PointInRect(&p, culling_rect)) outside = false;
-			p.y = dstrect.y + dstrect.h;
-			if (SDL_PointInRect(&p, culling_rect)) outside = false;
-			p.x = dstrect.x;
-			if (SDL_PointInRect(&p, culling_rect)) outside = false;
-			p.x = dstrect.x + dstrect.w / 2;
-			p.y = dstrect.y + dstrect.h / 2;
-			if (SDL_PointInRect(&p, culling_rect)) outside = false;
-			if (outside) return false;
-		} else {
-			return false;
-		}
+	Uint8 drawn{ 0 };
+	manipulateAll(&dstrect, &drawn, 1);
+	return drawn != 0;
+}
+size_t FD_Camera::manipulateAll(SDL_Rect* dstrects, Uint8* drawn, size_t count) const {
+	const int left{ culling_rect.x }, top{ culling_rect.y };
+	const int right{ culling_rect.x + culling_rect.w };
+	const int bottom{ culling_rect.y + culling_rect.h };
+	size_t total{ 0 };
+	for (size_t i = 0; i < count; i++) {
+		SDL_Rect& r{ dstrects[i] };
+		// Drawn if the rectangle isn't empty and touches the culling rectangle
+		Uint8 d{ static_cast<Uint8>((r.w > 0) & (r.h > 0)
+			& (r.x < right) & (r.x + r.w >= left) & (r.y < bottom) & (r.y + r.h >= top)) };
+		transform(r);
+		drawn[i] = d;
+		total += d;
 	}
-	// The camera values to use based on shake
-	double cx, cy, ca;
-	cx = bounds_center->x + max_x_shake * shake_amount * random_x->getNoise();
-	cy = bounds_center->y + max_y_shake * shake_amount * random_y->getNoise();
-	ca = this->angle->value() + max_angle_shake * shake_amount * random_angle->getNoise();
-	// x and y relative to camera center
-	double center_x = dstrect.x + dstrect.w / 2.0 - cx;
-	double center_y = dstrect.y + dstrect.h / 2.0 - cy;
-	// Create the dstrect with the correct width and height
-	SDL_Rect dr = { 0, 0,
-		static_cast<int>(dstrect.w * drawing_scale),
-		static_cast<int>(dstrect.h * drawing_scale) };
-	// Rotate the x and y around the camera center
-	dr.x = static_cast<int>(center_x * cos(FD_PI * ca / 180.0)
-		- center_y * sin(FD_PI * ca / 180.0));
-	dr.y = static_cast<int>(center_x * sin(FD_PI * ca / 180.0)
-		+ center_y * cos(FD_PI * ca / 180.0));
-	// Make relative to the screen
-	dr.x += bounds->w / 2 - dstrect.w / 2;
-	dr.y += bounds->h / 2 - dstrect.h / 2;
-	dr.x = static_cast<int>(dr.x * drawing_scale);
-	dr.y = static_cast<int>(dr.y * drawing_scale);
-	dstrect = dr;
-	return true;
+	return total;
+}
+
+bool FD_Camera::hasChangedSince(Uint32 ticks) const {
+	return shake_amount != 0 || x.changedSince(ticks) || y.changedSince(ticks)
+		|| w.changedSince(ticks) || scale.changedSince(ticks) || angle.changedSince(ticks);
 }
 
 void FD_Camera::still() { shake_amount = 0; }
@@ -135,54 +108,54 @@ void FD_Camera::shake(double amount) { shake_amount += amount; }
 void FD_Camera::toCameraCoordinates(int& x, int& y) const {
 	x = static_cast<int>(x / drawing_scale);
 	y = static_cast<int>(y / drawing_scale);
-	x += bounds->x;
-	y += bounds->y;
+	x += bounds.x;
+	y += bounds.y;
 }
 void FD_Camera::toScreenCoordinates(int& x, int& y) const {
-	x -= bounds->x;
-	y -= bounds->y;
+	x -= bounds.x;
+	y -= bounds.y;
 	x = static_cast<int>(x * drawing_scale);
 	y = static_cast<int>(y * drawing_scale);
 }
 void FD_Camera::toCameraCoordinates(double& x, double& y) const {
 	x /= drawing_scale;
 	y /= drawing_scale;
-	x += bounds->x;
-	y += bounds->y;
+	x += bounds.x;
+	y += bounds.y;
 }
 void FD_Camera::toScreenCoordinates(double& x, double& y) const {
-	x -= bounds->x;
-	y -= bounds->y;
+	x -= bounds.x;
+	y -= bounds.y;
 	x *= drawing_scale;
 	y *= drawing_scale;
 }
 
 int FD_Camera::getRotatedWidth() const {
-	double a = angle->value();
+	double a = angle.value();
 	while (a < 0) { a += 180.0; }
 	while (a > 180) { a -= 180.0; }
 	if (a > 90.0) a = 180 - a;
 	a *= FD_PI;
 	a /= 180.0;
-	return static_cast<int>(w->value() * scale->value() * cos(a)
-		+ w->value() * scale->value() * aspect_ratio * sin(a));
+	return static_cast<int>(w.value() * scale.value() * cos(a)
+		+ w.value() * scale.value() * aspect_ratio * sin(a));
 }
 int FD_Camera::getRotatedHeight() const {
-	double a = angle->value();
+	double a = angle.value();
 	while (a < 0) { a += 180.0; }
 	while (a > 180) { a -= 180.0; }
 	if (a > 90.0) a = 180 - a;
 	a *= FD_PI;
 	a /= 180.0;
-	return static_cast<int>(w->value() * scale->value() * sin(a)
-		+ w->value() * scale->value() * aspect_ratio * cos(a));
+	return static_cast<int>(w.value() * scale.value() * sin(a)
+		+ w.value() * scale.value() * aspect_ratio * cos(a));
 }
 
 int FD_Camera::getWidth() const { 
-	return static_cast<int>(w->value() * scale->value()); 
+	return static_cast<int>(w.value() * scale.value()); 
 }
 int FD_Camera::getHeight() const { 
-	return static_cast<int>(w->value() * scale->value() * aspect_ratio); 
+	return static_cast<int>(w.value() * scale.value() * aspect_ratio); 
 }
 int FD_Camera::getCullingRadius() const {
 	return culling_radius;
@@ -195,10 +168,10 @@ const std::function<double(double)> FD_Camera::getShakeDecrementer() const {
 }
 
 void FD_Camera::setWidth(double width) { 
-	w->set(width); 
+	w.set(width); 
 }
 void FD_Camera::setHeight(double height) { 
-	w->set(height / aspect_ratio); 
+	w.set(height / aspect_ratio); 
 }
 void FD_Camera::setCullingRadius(int radius) {
 	this->culling_radius = radius;
@@ -210,21 +183,21 @@ void FD_Camera::setShakeDecrementer(std::function<double(double)> f) {
 	this->shake_decrement = f;
 }
 
-const SDL_Rect* FD_Camera::getBounds() const { return bounds; }
+const SDL_Rect* FD_Camera::getBounds() const { return &bounds; }
 const SDL_Rect* FD_Camera::getCullingBounds() const {
-	return culling_rect;
+	return &culling_rect;
 }
 
-FD_Tween* FD_Camera::getTweenX() { return x; }
-FD_Tween* FD_Camera::getTweenY() { return y; }
-FD_Tween* FD_Camera::getTweenWidth() { return w; }
-FD_Tween* FD_Camera::getTweenScale() { return scale; }
-FD_Tween* FD_Camera::getTweenAngle() { return angle; }
+FD_Tween* FD_Camera::getTweenX() { return &x; }
+FD_Tween* FD_Camera::getTweenY() { return &y; }
+FD_Tween* FD_Camera::getTweenWidth() { return &w; }
+FD_Tween* FD_Camera::getTweenScale() { return &scale; }
+FD_Tween* FD_Camera::getTweenAngle() { return &angle; }
 
 bool FD_Camera::isMoving() {
-	return !(x->finished())
-		|| !(y->finished())
-		|| !(w->finished())
-		|| !(scale->finished())
-		|| !(angle->finished());
+	return !(x.done())
+		|| !(y.done())
+		|| !(w.done())
+		|| !(scale.done())
+		|| !(angle.done());
 }
@@ -26,20 +26,20 @@ class FD_Camera : public FD_Resizable,
 	public std::enable_shared_from_this<FD_Camera> {
 private:
 
-	FD_Tween* x;
-	FD_Tween* y;
-	FD_Tween* w;
-	FD_Tween* scale;
-	FD_Tween* angle;
+	FD_Tween x;
+	FD_Tween y;
+	FD_Tween w;
+	FD_Tween scale;
+	FD_Tween angle;
 
 	int resolution_width;
 	int resolution_height;
 	double aspect_ratio;
 	double drawing_scale;
 
-	FD_RandomGenerator* random_x;
-	FD_RandomGenerator* random_y;
-	FD_RandomGenerator* random_angle;
+	FD_RandomGenerator random_x;
+	FD_RandomGenerator random_y;
+	FD_RandomGenerator random_angle;
 
 	double shake_amount{ 0 };
 	double max_x_shake{ 0 };
@@ -50,13 +50,20 @@ private:
 	};
 
 	int culling_radius;
-	SDL_Rect* culling_rect;
-	SDL_Rect* bounds;
-	SDL_Rect* bounding_rect;
-	SDL_Point* bounds_center;
+	SDL_Rect culling_rect{};
+	SDL_Rect bounds{};
+	SDL_Rect bounding_rect{};
+	SDL_Point bounds_center{};
+
+	// The shaken center and rotation worked out once per frame by pre_render
+	double view_x{ 0 };
+	double view_y{ 0 };
+	double view_cos{ 1 };
+	double view_sin{ 0 };
 
 	int getRotatedWidth() const;
 	int getRotatedHeight() const;
+	void transform(SDL_Rect& dstrect) const;
 
 public:
 
@@ -78,6 +85,10 @@ public:
 	void associate(std::weak_ptr<FD_Window> window);
 
 	//! Prepares the FD_Camera for the manipulation associated with rendering.
+	/*!
+		This works out the culling rectangle and, the shake and rotation of
+		the frame, so that manipulating a rectangle needs no trigonometry.
+	*/
 	void pre_render();
 	//! Manipulates a given destination rectangle from arbitrary to window coordinates.
 	/*!
@@ -86,9 +97,31 @@ public:
 		\param dstrect The destination rectangle.
 		\param angle   The angle of the destination rectangle.
 
-		\return Returns whether the object should be drawn or not (if the destination intersects with the camera bounds).
+		\return Returns whether the object should be drawn or not (if the destination isn't empty and touches the culling bounds).
+
+		\sa manipulateAll
 	*/
 	bool manipulate(SDL_Rect& dstrect, double& angle) const;
+	//! Manipulates many destination rectangles from arbitrary to window coordinates in one pass.
+	/*!
+		Each rectangle is manipulated and culled as by manipulate, but without
+		branching, so the loop can be vectorised. Rectangles that shouldn't be
+		drawn are still changed.
+
+		\param dstrects The destination rectangles, changed in place.
+		\param drawn    The flags to write whether each rectangle should be drawn to.
+		\param count    The number of rectangles.
+
+		\return The number of rectangles that should be drawn.
+	*/
+	size_t manipulateAll(SDL_Rect* dstrects, Uint8* drawn, size_t count) const;
+	//! Returns whether the FD_Camera has moved, zoomed, turned or, shaken since a given time.
+	/*!
+		\param ticks The engine time to check from.
+
+		\return Whether destination rectangles may be manipulated differently since the time.
+	*/
+	bool hasChangedSince(Uint32 ticks) const;
 
 	//! Updates the FD_Camera.
 	/*!
@@ -2,6 +2,12 @@
 
 FD_CameraSet::FD_CameraSet(std::weak_ptr<FD_Window> window) {
 	this->window = window;
+	// Switch to the next camera once a transition has finished
+	transition_timeline = std::make_shared<FD_TweenTimeline>();
+	transition_timeline->setCompletionCallback([this]() {
+		temping = false;
+		this->setCamera(next_camera);
+	});
 }
 FD_CameraSet::~FD_CameraSet() {}
 
@@ -9,11 +15,8 @@ void FD_CameraSet::update() {
 	if (temping) {
 		if (temp_camera != nullptr) {
 			temp_camera->update();
-			if (!temp_camera->isMoving()) {
-				temping = false;
-				this->setCamera(next_camera);
-			}
 		} else {
+			transition_timeline->stop();
 			temping = false;
 		}
 	}
@@ -65,21 +68,23 @@ void FD_CameraSet::transition(std::shared_ptr<FD_Camera> from,
 	FD_TweenAction a;
 	a.type = cam_tran_type;
 	a.duration = cam_tran_duration;
+	transition_timeline->clear();
 	// x
 	a.destination = to->getTweenX()->value();
-	from->getTweenX()->apply(a);
+	transition_timeline->add(from->getTweenX(), a);
 	// y
 	a.destination = to->getTweenY()->value();
-	from->getTweenY()->apply(a);
+	transition_timeline->add(from->getTweenY(), a);
 	// width and scale
 	double pre_w = from->getWidth();
 	from->getTweenWidth()->set(to->getTweenWidth()->value());
 	a.destination = to->getTweenScale()->value();
 	from->getTweenScale()->set(pre_w / from->getTweenWidth()->value());
-	from->getTweenScale()->apply(a);
+	transition_timeline->add(from->getTweenScale(), a);
 	// angle
 	a.destination = to->getTweenAngle()->value();
-	from->getTweenAngle()->apply(a);
+	transition_timeline->add(from->getTweenAngle(), a);
+	transition_timeline->play();
 }
 void FD_CameraSet::setCameraTransition(FD_CameraTransition tran) {
 	cam_tran = tran;
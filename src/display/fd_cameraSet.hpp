@@ -5,6 +5,7 @@
 
 #include "fd_window.hpp"
 #include "fd_camera.hpp"
+#include "../maths/fd_tweenTimeline.hpp"
 
 /*!
 	@file
@@ -54,6 +55,7 @@ private:
 	bool temping{ false };
 	FD_CameraIndex next_camera;
 	std::shared_ptr<FD_Camera> temp_camera;
+	std::shared_ptr<FD_TweenTimeline> transition_timeline;
 
 	void transition(std::shared_ptr<FD_Camera> from,
 		std::shared_ptr<FD_Camera> to);
@@ -0,0 +1,89 @@
+#include "fd_groupCache.hpp"
+
+#include "../main/fd_handling.hpp"
+
+FD_GroupCache::FD_GroupCache() : FD_Image(IT_CACHE), FD_Resizable() {}
+FD_GroupCache::~FD_GroupCache() {}
+
+SDL_BlendMode FD_GroupCache::getCompositeBlendMode() {
+	static const SDL_BlendMode composite{ SDL_ComposeCustomBlendMode(
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD) };
+	return composite;
+}
+
+void FD_GroupCache::submit(FD_RenderSnapshot& recording) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	pending.swap(recording);
+	recording.clear();
+	submitted = true;
+}
+bool FD_GroupCache::hasBeenLost() {
+	return lost.exchange(false);
+}
+
+void FD_GroupCache::redraw(FD_RenderState& state, int width, int height) {
+	SDL_Renderer* renderer{ state.getRenderer() };
+	if (texture == nullptr || static_cast<int>(texture_width) != width
+		|| static_cast<int>(texture_height) != height) {
+		if (texture != nullptr) SDL_DestroyTexture(texture);
+		texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+			SDL_TEXTUREACCESS_TARGET, width, height);
+		if (texture == nullptr) {
+			loaded = false;
+			FD_Handling::errorSDL("The texture of a group cache could not be created.");
+			return;
+		}
+		this->query();
+		// Fall back to blending the colours again where custom blend modes aren't supported
+		premultiplied = SDL_SetTextureBlendMode(texture, getCompositeBlendMode()) == 0;
+	}
+	SDL_Texture* target{ SDL_GetRenderTarget(renderer) };
+	SDL_SetRenderTarget(renderer, texture);
+	// Changing the target resets the clip rectangle, so the cached state is wrong
+	state.invalidate();
+	state.setDrawColour(0, 0, 0, 0);
+	SDL_RenderClear(renderer);
+	content.execute(state, &sprites, &primitives);
+	SDL_SetRenderTarget(renderer, target);
+	state.invalidate();
+	redraws++;
+}
+
+void FD_GroupCache::render(FD_RenderState& state, Uint8 alpha,
+	const SDL_Rect* srcrect, const SDL_Rect* dstrect,
+	double angle, double center_x, double center_y, SDL_RendererFlip flip,
+	SDL_BlendMode blend, const SDL_Rect* clip) {
+	bool fresh{ false };
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		if (submitted) {
+			content.swap(pending);
+			submitted = false;
+			fresh = true;
+		}
+	}
+	int width{ 0 }, height{ 0 };
+	SDL_GetRendererOutputSize(state.getRenderer(), &width, &height);
+	if (width <= 0 || height <= 0) return;
+	if (fresh || texture == nullptr || static_cast<int>(texture_width) != width
+		|| static_cast<int>(texture_height) != height) {
+		redraw(state, width, height);
+	}
+	if (premultiplied) {
+		// The colours hold their alpha already, so fade them with it
+		state.setTextureColourMod(texture, alpha, alpha, alpha);
+		FD_Image::render(state, alpha, nullptr, nullptr, 0, 0.5, 0.5, SDL_FLIP_NONE,
+			getCompositeBlendMode(), clip);
+	} else {
+		FD_Image::render(state, alpha, nullptr, nullptr, 0, 0.5, 0.5, SDL_FLIP_NONE,
+			SDL_BLENDMODE_BLEND, clip);
+	}
+}
+bool FD_GroupCache::isBatchable() const { return false; }
+
+void FD_GroupCache::resized(int width, int height) {
+	lost = true;
+}
+
+Uint64 FD_GroupCache::getRedrawCount() const { return redraws; }
@@ -0,0 +1,142 @@
+#ifndef FD_GROUP_CACHE_H_
+#define FD_GROUP_CACHE_H_
+
+#include <mutex>
+#include <atomic>
+
+#include <SDL_render.h>
+
+#include "fd_resizable.hpp"
+#include "fd_renderState.hpp"
+#include "fd_renderSnapshot.hpp"
+#include "fd_spriteBatch.hpp"
+#include "fd_primitiveBatch.hpp"
+#include "../input/fd_imageManager.hpp"
+
+/*!
+	@file
+	@brief The file containing the FD_GroupCache class.
+*/
+
+//! The FD_GroupCache class, the render target a static object group is drawn to once and, copied from every frame.
+/*!
+	The group records its objects to a snapshot and submits it whenever they
+	change, which may be on another thread. The cache draws the latest
+	snapshot to its texture as it is next drawn itself, so the renderer is only
+	used by the thread drawing. The texture covers the whole window and, is
+	made again when the size of the window changes.
+
+	Like FD_PureImage, add the cache to the window's resizable list, as the
+	texture is lost when the window is resized.
+
+	Blending objects onto the transparent texture leaves their colours
+	multiplied by their alpha, so the texture is copied with a premultiplied
+	alpha blend mode, with the opacity of the copy applied to its colour too.
+	Copied otherwise, anything not opaque would be drawn darker.
+
+	\warning Renderers without custom blend modes, such as the software
+	renderer, copy the texture with SDL_BLENDMODE_BLEND, so objects that
+	aren't opaque are drawn slightly darker through them.
+
+	\sa FD_ObjectGroup::setStatic
+*/
+class FD_GroupCache : public FD_Image, public FD_Resizable {
+private:
+
+	std::mutex mutex;
+	FD_RenderSnapshot pending{};
+	bool submitted{ false };
+	FD_RenderSnapshot content{};
+	std::atomic<bool> lost{ true };
+
+	FD_SpriteBatch sprites{};
+	FD_PrimitiveBatch primitives{};
+	Uint64 redraws{ 0 };
+	bool premultiplied{ false };
+
+	void redraw(FD_RenderState& state, int width, int height);
+
+public:
+
+	using FD_Image::render;
+
+	//! Constructs a FD_GroupCache.
+	/*!
+		The texture is made when the cache is first drawn.
+	*/
+	FD_GroupCache();
+	//! Destroys the FD_GroupCache.
+	~FD_GroupCache();
+
+	//! Returns the blend mode the texture is copied with, adding colours premultiplied by their alpha.
+	/*!
+		\return The blend mode.
+	*/
+	static SDL_BlendMode getCompositeBlendMode();
+
+	//! Hands over the commands to draw to the cache.
+	/*!
+		The commands are swapped out of the recording, which is given back the
+		storage of an earlier submission, cleared, to record to next time.
+
+		\param recording The commands to draw, in window coordinates.
+	*/
+	void submit(FD_RenderSnapshot& recording);
+	//! Returns whether the texture has been lost since this was last checked.
+	/*!
+		\return Whether the cache should be recorded again.
+
+		\warning This method is not const, using it may affect the function of other classes if used improperly.
+	*/
+	bool hasBeenLost();
+
+	//! Copies the texture over the whole window, drawing any submitted commands to it first.
+	/*!
+		The source and destination rectangles, angle, center and, flip flags
+		are ignored, as the texture always covers the window. The blend mode
+		is ignored too, as the texture is copied with getCompositeBlendMode
+		where the renderer supports it.
+
+		\param state    The cache of the state of the renderer to draw with.
+		\param alpha    The alpha of the copy.
+		\param srcrect  Unused.
+		\param dstrect  Unused.
+		\param angle    Unused.
+		\param center_x Unused.
+		\param center_y Unused.
+		\param flip     Unused.
+		\param blend    Unused.
+		\param clip     The clip rectangle of the copy.
+	*/
+	void render(FD_RenderState& state,
+		Uint8 alpha = 255,
+		const SDL_Rect* srcrect = nullptr,
+		const SDL_Rect* dstrect = nullptr,
+		double angle = 0.0,
+		double center_x = 0.5,
+		double center_y = 0.5,
+		SDL_RendererFlip flip = SDL_FLIP_NONE,
+		SDL_BlendMode blend = SDL_BLENDMODE_NONE,
+		const SDL_Rect* clip = nullptr) override;
+	//! Returns false, as the cache may draw to its texture before it is copied.
+	/*!
+		\return Whether the image can be batched.
+	*/
+	bool isBatchable() const override;
+
+	//! When the window is resized, the video device is lost - this has the cache drawn again.
+	/*!
+		\param width  The new width of the window.
+		\param height The new height of the window.
+	*/
+	void resized(int width, int height) override;
+
+	//! Returns the number of times the texture has been drawn to.
+	/*!
+		\return The number of redraws.
+	*/
+	Uint64 getRedrawCount() const;
+
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "fd_primitiveBatch.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+
+FD_PrimitiveBatch::FD_PrimitiveBatch() {}
+FD_PrimitiveBatch::~FD_PrimitiveBatch() {}
+
+void FD_PrimitiveBatch::begin(FD_RenderState& state, SDL_BlendMode blend, const SDL_Rect* clip) {
+	// A box gives at most six rectangles
+	bool clipping{ clip != nullptr };
+	if (!rects.empty() && (blend != this->blend || clipping != has_clip
+		|| (clipping && (clip->x != this->clip.x || clip->y != this->clip.y
+		|| clip->w != this->clip.w || clip->h != this->clip.h))
+		|| rects.size() + 6 > max_rects)) {
+		flush(state);
+	}
+	if (rects.empty()) {
+		this->blend = blend;
+		has_clip = clipping;
+		if (clipping) this->clip = *clip;
+	}
+}
+void FD_PrimitiveBatch::push(const SDL_Rect& rect, SDL_Colour colour) {
+	if (rect.w <= 0 || rect.h <= 0) return;
+	// Transparent colours only change anything when they aren't blended
+	if (colour.a == 0 && (blend == SDL_BLENDMODE_BLEND || blend == SDL_BLENDMODE_ADD)) return;
+	rects.push_back({ rect, colour });
+}
+void FD_PrimitiveBatch::fill(FD_RenderState& state, size_t first, size_t last) {
+	const SDL_Colour& c{ rects[first].colour };
+	state.setDrawColour(c.r, c.g, c.b, c.a);
+	run.clear();
+	for (size_t i = first; i < last; i++) run.push_back(rects[i].rect);
+	SDL_RenderFillRects(state.getRenderer(), run.data(), static_cast<int>(run.size()));
+	calls++;
+}
+
+void FD_PrimitiveBatch::addBox(FD_RenderState& state, const SDL_Rect& rect, SDL_Colour underlay,
+	SDL_Colour outline, SDL_Colour overlay, SDL_BlendMode blend, const SDL_Rect* clip) {
+	begin(state, blend, clip);
+	push(rect, underlay);
+	// The outline is the edges SDL_RenderDrawRect would draw, without overlapping corners
+	push({ rect.x, rect.y, rect.w, 1 }, outline);
+	if (rect.h > 1) push({ rect.x, rect.y + rect.h - 1, rect.w, 1 }, outline);
+	if (rect.h > 2) {
+		push({ rect.x, rect.y + 1, 1, rect.h - 2 }, outline);
+		if (rect.w > 1) push({ rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2 }, outline);
+	}
+	push(rect, overlay);
+	primitives++;
+}
+bool FD_PrimitiveBatch::addLine(FD_RenderState& state, int x1, int y1, int x2, int y2,
+	SDL_Colour colour, SDL_BlendMode blend, const SDL_Rect* clip) {
+	if (x1 != x2 && y1 != y2) return false;
+	begin(state, blend, clip);
+	push({ std::min(x1, x2), std::min(y1, y2),
+		std::abs(x2 - x1) + 1, std::abs(y2 - y1) + 1 }, colour);
+	primitives++;
+	return true;
+}
+void FD_PrimitiveBatch::flush(FD_RenderState& state) {
+	if (rects.empty()) return;
+	state.setClipRect(has_clip ? &clip : nullptr);
+	state.setDrawBlendMode(blend);
+	auto same = [](const Rect& a, const Rect& b) {
+		return a.colour.r == b.colour.r && a.colour.g == b.colour.g
+			&& a.colour.b == b.colour.b && a.colour.a == b.colour.a;
+	};
+	auto differs = [this, &same](const Rect& r) { return !same(r, rects.front()); };
+	if (std::none_of(rects.begin(), rects.end(), differs)) {
+		fill(state, 0, rects.size());
+	} else {
+#ifdef FD_SPRITE_BATCHING
+		// Give each rectangle its colour through its vertices, keeping the order drawn
+		vertices.clear();
+		for (const Rect& r : rects) {
+			float x0{ static_cast<float>(r.rect.x) }, y0{ static_cast<float>(r.rect.y) };
+			float x1{ static_cast<float>(r.rect.x + r.rect.w) };
+			float y1{ static_cast<float>(r.rect.y + r.rect.h) };
+			vertices.push_back({ { x0, y0 }, r.colour, { 0, 0 } });
+			vertices.push_back({ { x1, y0 }, r.colour, { 0, 0 } });
+			vertices.push_back({ { x1, y1 }, r.colour, { 0, 0 } });
+			vertices.push_back({ { x0, y1 }, r.colour, { 0, 0 } });
+		}
+		while (indices.size() < rects.size() * 6) {
+			int first{ static_cast<int>(indices.size() / 6 * 4) };
+			for (int i : { 0, 1, 2, 0, 2, 3 }) indices.push_back(first + i);
+		}
+		SDL_RenderGeometry(state.getRenderer(), nullptr, vertices.data(),
+			static_cast<int>(vertices.size()), indices.data(), static_cast<int>(rects.size() * 6));
+		calls++;
+#else
+		size_t first{ 0 };
+		for (size_t i = 1; i <= rects.size(); i++) {
+			if (i == rects.size() || !same(rects[i], rects[first])) {
+				fill(state, first, i);
+				first = i;
+			}
+		}
+#endif
+	}
+	rects.clear();
+}
+
+Uint64 FD_PrimitiveBatch::getPrimitiveCount() const { return primitives; }
+Uint64 FD_PrimitiveBatch::getCallCount() const { return calls; }
@@ -0,0 +1,112 @@
+#ifndef FD_PRIMITIVE_BATCH_H_
+#define FD_PRIMITIVE_BATCH_H_
+
+#include <vector>
+
+#include <SDL_render.h>
+
+#include "fd_renderState.hpp"
+#include "fd_spriteBatch.hpp"
+
+/*!
+	@file
+	@brief The file containing the FD_PrimitiveBatch class.
+*/
+
+//! The class that collects consecutive boxes and lines sharing a blend mode and clip rectangle into few draw calls.
+/*!
+	Everything is collected as filled rectangles in the order drawn: a box
+	gives its underlay, the four edges of its outline and, its overlay, and
+	lines along an axis give a rectangle one pixel thick. When the batch is
+	flushed, rectangles that all share a colour are drawn by one
+	SDL_RenderFillRects call and, otherwise by one SDL_RenderGeometry call with
+	the colours in the vertices, or before SDL 2.0.18, one SDL_RenderFillRects
+	call per run of a colour.
+
+	Diagonal lines can't be drawn as rectangles, so are left to
+	SDL_RenderDrawLine.
+
+	\sa FD_RenderSnapshot::execute
+*/
+class FD_PrimitiveBatch {
+private:
+
+	struct Rect {
+		SDL_Rect rect;
+		SDL_Colour colour;
+	};
+
+	std::vector<Rect> rects{};
+	std::vector<SDL_Rect> run{};
+#ifdef FD_SPRITE_BATCHING
+	std::vector<SDL_Vertex> vertices{};
+	std::vector<int> indices{};
+#endif
+	SDL_BlendMode blend{ SDL_BLENDMODE_NONE };
+	bool has_clip{ false };
+	SDL_Rect clip{ };
+
+	Uint64 primitives{ 0 };
+	Uint64 calls{ 0 };
+
+	void begin(FD_RenderState& state, SDL_BlendMode blend, const SDL_Rect* clip);
+	void push(const SDL_Rect& rect, SDL_Colour colour);
+	void fill(FD_RenderState& state, size_t first, size_t last);
+
+public:
+
+	//! The most rectangles drawn by one call.
+	static const size_t max_rects{ 8192 };
+
+	//! Constructs a FD_PrimitiveBatch.
+	FD_PrimitiveBatch();
+	//! Destroys the FD_PrimitiveBatch.
+	~FD_PrimitiveBatch();
+
+	//! Adds a box, drawing the batch first if the box can't join it.
+	/*!
+		\param state    The cache of the state of the renderer to draw with.
+		\param rect     The area of the box.
+		\param underlay The colour filled under the outline.
+		\param outline  The colour of the outline.
+		\param overlay  The colour filled over the outline.
+		\param blend    The blend mode of the box.
+		\param clip     The clip rectangle of the box, or nullptr.
+	*/
+	void addBox(FD_RenderState& state, const SDL_Rect& rect, SDL_Colour underlay,
+		SDL_Colour outline, SDL_Colour overlay, SDL_BlendMode blend, const SDL_Rect* clip);
+	//! Adds a line, drawing the batch first if the line can't join it.
+	/*!
+		\param state  The cache of the state of the renderer to draw with.
+		\param x1     The x-coordinate of the start of the line.
+		\param y1     The y-coordinate of the start of the line.
+		\param x2     The x-coordinate of the end of the line.
+		\param y2     The y-coordinate of the end of the line.
+		\param colour The colour of the line.
+		\param blend  The blend mode of the line.
+		\param clip   The clip rectangle of the line, or nullptr.
+
+		\return Whether the line was added, if not it is diagonal and should be drawn after flushing.
+	*/
+	bool addLine(FD_RenderState& state, int x1, int y1, int x2, int y2,
+		SDL_Colour colour, SDL_BlendMode blend, const SDL_Rect* clip);
+	//! Draws and empties the batch.
+	/*!
+		\param state The cache of the state of the renderer to draw with.
+	*/
+	void flush(FD_RenderState& state);
+
+	//! Returns the number of boxes and lines batched so far.
+	/*!
+		\return The number of boxes and lines batched.
+	*/
+	Uint64 getPrimitiveCount() const;
+	//! Returns the number of draw calls the batched boxes and lines took.
+	/*!
+		\return The number of draw calls.
+	*/
+	Uint64 getCallCount() const;
+
+};
+
+#endif
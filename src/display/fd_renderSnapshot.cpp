@@ -0,0 +1,193 @@
+#include "fd_renderSnapshot.hpp"
+
+#include <utility>
+#include <algorithm>
+
+// Draw Command Member Functions
+
+void FD_DrawCommand::execute(SDL_Renderer* renderer) const {
+	switch (type) {
+	case FD_DRAW_IMAGE:
+		if (image == nullptr) return;
+		image->render(renderer, alpha, has_srcrect ? &srcrect : nullptr, &dstrect,
+			angle, center_x, center_y, flip, blend, has_clip ? &clip : nullptr);
+		return;
+	case FD_DRAW_LINE:
+	case FD_DRAW_BOX:
+		break;
+	default:
+		return;
+	}
+	// Set up the clipping and blending for the primitives
+	if (has_clip) SDL_RenderSetClipRect(renderer, &clip);
+	SDL_BlendMode old_blend{ };
+	SDL_GetRenderDrawBlendMode(renderer, &old_blend);
+	SDL_SetRenderDrawBlendMode(renderer, blend);
+	if (type == FD_DRAW_LINE) {
+		SDL_SetRenderDrawColor(renderer, colour.r, colour.g, colour.b, colour.a);
+		SDL_RenderDrawLine(renderer, dstrect.x, dstrect.y,
+			dstrect.x + dstrect.w, dstrect.y + dstrect.h);
+	} else {
+		SDL_SetRenderDrawColor(renderer, underlay_colour.r,
+			underlay_colour.g, underlay_colour.b, underlay_colour.a);
+		SDL_RenderFillRect(renderer, &dstrect);
+		SDL_SetRenderDrawColor(renderer, colour.r, colour.g, colour.b, colour.a);
+		SDL_RenderDrawRect(renderer, &dstrect);
+		SDL_SetRenderDrawColor(renderer, overlay_colour.r,
+			overlay_colour.g, overlay_colour.b, overlay_colour.a);
+		SDL_RenderFillRect(renderer, &dstrect);
+	}
+	if (has_clip) SDL_RenderSetClipRect(renderer, nullptr);
+	SDL_SetRenderDrawBlendMode(renderer, old_blend);
+}
+
+void FD_DrawCommand::execute(FD_RenderState& state) const {
+	SDL_Renderer* renderer{ state.getRenderer() };
+	switch (type) {
+	case FD_DRAW_IMAGE:
+		if (image == nullptr) return;
+		image->render(state, alpha, has_srcrect ? &srcrect : nullptr, &dstrect,
+			angle, center_x, center_y, flip, blend, has_clip ? &clip : nullptr);
+		return;
+	case FD_DRAW_LINE:
+		state.setClipRect(has_clip ? &clip : nullptr);
+		state.setDrawBlendMode(blend);
+		state.setDrawColour(colour.r, colour.g, colour.b, colour.a);
+		SDL_RenderDrawLine(renderer, dstrect.x, dstrect.y,
+			dstrect.x + dstrect.w, dstrect.y + dstrect.h);
+		return;
+	case FD_DRAW_BOX:
+		state.setClipRect(has_clip ? &clip : nullptr);
+		state.setDrawBlendMode(blend);
+		state.setDrawColour(underlay_colour.r,
+			underlay_colour.g, underlay_colour.b, underlay_colour.a);
+		SDL_RenderFillRect(renderer, &dstrect);
+		state.setDrawColour(colour.r, colour.g, colour.b, colour.a);
+		SDL_RenderDrawRect(renderer, &dstrect);
+		state.setDrawColour(overlay_colour.r,
+			overlay_colour.g, overlay_colour.b, overlay_colour.a);
+		SDL_RenderFillRect(renderer, &dstrect);
+		return;
+	default:
+		return;
+	}
+}
+void FD_DrawCommand::execute(FD_RenderState& state, FD_SpriteBatch* sprites,
+	FD_PrimitiveBatch* primitives) const {
+	// Only one batch holds commands at a time, so the order is kept
+	if (type == FD_DRAW_IMAGE) {
+		if (primitives != nullptr) primitives->flush(state);
+		if (sprites != nullptr) {
+			if (image != nullptr && sprites->add(state, *image, alpha,
+				has_srcrect ? &srcrect : nullptr, dstrect, angle, center_x, center_y, flip,
+				blend, has_clip ? &clip : nullptr)) {
+				return;
+			}
+			sprites->flush(state);
+		}
+	} else {
+		if (sprites != nullptr) sprites->flush(state);
+		if (primitives != nullptr) {
+			const SDL_Rect* c{ has_clip ? &clip : nullptr };
+			if (type == FD_DRAW_BOX) {
+				primitives->addBox(state, dstrect, underlay_colour, colour, overlay_colour, blend, c);
+				return;
+			}
+			if (type == FD_DRAW_LINE && primitives->addLine(state, dstrect.x, dstrect.y,
+				dstrect.x + dstrect.w, dstrect.y + dstrect.h, colour, blend, c)) {
+				return;
+			}
+			primitives->flush(state);
+		}
+	}
+	execute(state);
+}
+
+// Render Snapshot Member Functions
+
+FD_RenderSnapshot::FD_RenderSnapshot() {}
+FD_RenderSnapshot::~FD_RenderSnapshot() {}
+
+FD_DrawCommand& FD_RenderSnapshot::add() {
+	if (size == commands.size()) commands.emplace_back();
+	return commands[size++];
+}
+void FD_RenderSnapshot::pop() {
+	if (size > 0) commands[--size].image = nullptr;
+}
+void FD_RenderSnapshot::clear() {
+	// Release the images but keep the storage
+	for (size_t i = 0; i < size; i++) commands[i].image = nullptr;
+	size = 0;
+	order.clear();
+	sorted = false;
+}
+void FD_RenderSnapshot::sort() {
+	keys.resize(size);
+	order.resize(size);
+	for (size_t i = 0; i < size; i++) {
+		const FD_DrawCommand& c{ commands[i] };
+		// The texture is taken from the command, as the image may be remade as this sorts
+		keys[i] = { c.layer, c.texture, c.blend, c.has_clip, c.clip };
+		order[i] = static_cast<Uint32>(i);
+	}
+	// Only runs within a layer are sorted, so the layers keep the order recorded
+	size_t begin{ 0 };
+	while (begin < size) {
+		size_t end{ begin + 1 };
+		while (end < size && keys[end].layer == keys[begin].layer) end++;
+		std::stable_sort(order.begin() + begin, order.begin() + end, [this](Uint32 a, Uint32 b) {
+			const SortKey& x{ keys[a] };
+			const SortKey& y{ keys[b] };
+			if (x.texture != y.texture) return std::less<const SDL_Texture*>()(x.texture, y.texture);
+			if (x.blend != y.blend) return x.blend < y.blend;
+			if (x.has_clip != y.has_clip) return y.has_clip;
+			if (!x.has_clip) return false;
+			if (x.clip.x != y.clip.x) return x.clip.x < y.clip.x;
+			if (x.clip.y != y.clip.y) return x.clip.y < y.clip.y;
+			if (x.clip.w != y.clip.w) return x.clip.w < y.clip.w;
+			return x.clip.h < y.clip.h;
+		});
+		begin = end;
+	}
+	sorted = true;
+}
+
+void FD_RenderSnapshot::swap(FD_RenderSnapshot& other) {
+	commands.swap(other.commands);
+	std::swap(size, other.size);
+	keys.swap(other.keys);
+	order.swap(other.order);
+	std::swap(sorted, other.sorted);
+}
+
+void FD_RenderSnapshot::execute(SDL_Renderer* renderer) const {
+	size_t i{ 0 };
+	if (sorted) {
+		for (; i < order.size(); i++) commands[order[i]].execute(renderer);
+	}
+	for (; i < size; i++) commands[i].execute(renderer);
+}
+
+void FD_RenderSnapshot::execute(FD_RenderState& state) const {
+	size_t i{ 0 };
+	if (sorted) {
+		for (; i < order.size(); i++) commands[order[i]].execute(state);
+	}
+	for (; i < size; i++) commands[i].execute(state);
+}
+void FD_RenderSnapshot::execute(FD_RenderState& state, FD_SpriteBatch* sprites,
+	FD_PrimitiveBatch* primitives) const {
+	size_t i{ 0 };
+	if (sorted) {
+		for (; i < order.size(); i++) commands[order[i]].execute(state, sprites, primitives);
+	}
+	for (; i < size; i++) commands[i].execute(state, sprites, primitives);
+	if (sprites != nullptr) sprites->flush(state);
+	if (primitives != nullptr) primitives->flush(state);
+}
+
+size_t FD_RenderSnapshot::getSize() const { return size; }
+const FD_DrawCommand& FD_RenderSnapshot::at(size_t index) const {
+	return commands.at(index);
+}
@@ -0,0 +1,207 @@
+#ifndef FD_RENDER_SNAPSHOT_H_
+#define FD_RENDER_SNAPSHOT_H_
+
+#include <memory>
+#include <vector>
+
+#include <SDL_render.h>
+
+#include "fd_renderState.hpp"
+#include "fd_spriteBatch.hpp"
+#include "fd_primitiveBatch.hpp"
+#include "../input/fd_imageManager.hpp"
+
+/*!
+	@file
+	@brief The file containing the FD_DrawCommand structure and the FD_RenderSnapshot class.
+*/
+
+//! The enumeration containing the kinds of draw command.
+enum FD_DrawType {
+	//! Draws an image, as FD_Image::render would.
+	FD_DRAW_IMAGE,
+	//! Draws a line from the top left to the bottom right of the destination.
+	FD_DRAW_LINE,
+	//! Draws a filled underlay, an outline and, a filled overlay over the destination.
+	FD_DRAW_BOX
+};
+
+//! The structure containing everything needed to draw an object once.
+/*!
+	The values are copied from an object and camera when the command is made,
+	so executing it reads no object state. Opacities are already applied to the
+	alpha of the colours and, to alpha for images.
+*/
+struct FD_DrawCommand {
+	//! The kind of command.
+	FD_DrawType type{ FD_DRAW_IMAGE };
+	//! The layer of the object the command was made from.
+	int layer{ 0 };
+
+	//! The image drawn by FD_DRAW_IMAGE.
+	std::shared_ptr<FD_Image> image{ nullptr };
+	//! The texture of the image when the command was made, which snapshots are sorted by but never draw.
+	const SDL_Texture* texture{ nullptr };
+	//! Whether the source rectangle is used, otherwise the whole image is drawn.
+	bool has_srcrect{ false };
+	//! The source rectangle of the image.
+	SDL_Rect srcrect{ };
+	//! The destination rectangle in window coordinates.
+	SDL_Rect dstrect{ };
+	//! The angle of the image.
+	double angle{ 0 };
+	//! The x center of the image, in units of the image's width.
+	double center_x{ 0.5 };
+	//! The y center of the image, in units of the image's height.
+	double center_y{ 0.5 };
+	//! The flip flags of the image.
+	SDL_RendererFlip flip{ SDL_FLIP_NONE };
+	//! The alpha of the image.
+	Uint8 alpha{ 255 };
+
+	//! The blend mode of the command.
+	SDL_BlendMode blend{ SDL_BLENDMODE_BLEND };
+	//! Whether the clip rectangle is used.
+	bool has_clip{ false };
+	//! The clip rectangle of the command.
+	SDL_Rect clip{ };
+
+	//! The colour of a line or the outline of a box.
+	SDL_Colour colour{ 0, 0, 0, 0 };
+	//! The underlay colour of a box.
+	SDL_Colour underlay_colour{ 0, 0, 0, 0 };
+	//! The overlay colour of a box.
+	SDL_Colour overlay_colour{ 0, 0, 0, 0 };
+
+	//! Draws the command.
+	/*!
+		\param renderer The renderer to draw with.
+	*/
+	void execute(SDL_Renderer* renderer) const;
+	//! Draws the command through a cache of the renderer's state.
+	/*!
+		The state set for the command is left as it is for the next command.
+
+		\param state The cache of the state of the renderer to draw with.
+	*/
+	void execute(FD_RenderState& state) const;
+	//! Draws the command, adding it to a batch where possible.
+	/*!
+		Each batch is flushed before anything it couldn't take is drawn, so the
+		draw order is kept.
+
+		\param state      The cache of the state of the renderer to draw with.
+		\param sprites    The batch to add images to, or nullptr to draw them alone.
+		\param primitives The batch to add lines and boxes to, or nullptr to draw them alone.
+	*/
+	void execute(FD_RenderState& state, FD_SpriteBatch* sprites,
+		FD_PrimitiveBatch* primitives) const;
+};
+
+//! The class containing an ordered list of draw commands.
+/*!
+	A snapshot is recorded from the objects of a scene at one point in time and,
+	can be drawn later, possibly by a different thread, without touching them.
+	Commands are kept in the order they were recorded, which is the draw order.
+	The storage is reused when the snapshot is cleared, so recording into the
+	same snapshot every frame does not allocate once it has grown.
+
+	Sorting a snapshot groups the commands of each layer by texture, blend
+	mode and, clip rectangle so that renderer state changes less between
+	them, which batching relies on. It orders the commands without moving
+	them, keeping the recorded order between equal commands.
+*/
+class FD_RenderSnapshot {
+private:
+
+	struct SortKey {
+		int layer;
+		const SDL_Texture* texture;
+		SDL_BlendMode blend;
+		bool has_clip;
+		SDL_Rect clip;
+	};
+
+	std::vector<FD_DrawCommand> commands{};
+	size_t size{ 0 };
+
+	std::vector<SortKey> keys{};
+	std::vector<Uint32> order{};
+	bool sorted{ false };
+
+public:
+
+	//! Constructs a FD_RenderSnapshot.
+	FD_RenderSnapshot();
+	//! Destroys the FD_RenderSnapshot.
+	~FD_RenderSnapshot();
+
+	//! Returns a new command at the end of the snapshot to be filled in.
+	/*!
+		The command may hold the values of one previously cleared, so each
+		value used by its type should be set.
+
+		\return The new command.
+	*/
+	FD_DrawCommand& add();
+	//! Removes the last command, usually one that turned out not to be drawn.
+	void pop();
+	//! Removes all commands, keeping their storage.
+	void clear();
+	//! Sorts the commands of each layer by texture, blend mode and, clip rectangle.
+	/*!
+		The layers themselves stay in the order recorded, which should be ascending.
+		Commands added after sorting are drawn after the sorted commands.
+
+		\warning Objects in the same layer that overlap may be drawn in a different order.
+	*/
+	void sort();
+	//! Exchanges the commands of two snapshots without copying them.
+	/*!
+		\param other The snapshot to exchange with.
+	*/
+	void swap(FD_RenderSnapshot& other);
+
+	//! Draws every command in order, sorted if sort has been called.
+	/*!
+		\param renderer The renderer to draw with.
+	*/
+	void execute(SDL_Renderer* renderer) const;
+	//! Draws every command in order through a cache of the renderer's state.
+	/*!
+		Only the state that differs between consecutive commands is set, which
+		sorting makes more common.
+
+		\param state The cache of the state of the renderer to draw with.
+	*/
+	void execute(FD_RenderState& state) const;
+	//! Draws every command in order, batching consecutive commands that share their state.
+	/*!
+		Sorting makes consecutive images sharing a texture, blend mode and, clip
+		rectangle more common, so fewer draw calls are needed.
+
+		\param state      The cache of the state of the renderer to draw with.
+		\param sprites    The batch to draw images through, or nullptr, flushed before returning.
+		\param primitives The batch to draw lines and boxes through, or nullptr, flushed before returning.
+
+		\sa FD_SpriteBatch, FD_PrimitiveBatch
+	*/
+	void execute(FD_RenderState& state, FD_SpriteBatch* sprites,
+		FD_PrimitiveBatch* primitives) const;
+
+	//! Returns the number of commands.
+	/*!
+		\return The number of commands.
+	*/
+	size_t getSize() const;
+	//! Returns a specific command.
+	/*!
+		\param index The index of the command.
+
+		\return The command.
+	*/
+	const FD_DrawCommand& at(size_t index) const;
+
+};
+
+#endif
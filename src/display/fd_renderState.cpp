@@ -0,0 +1,84 @@
+#include "fd_renderState.hpp"
+
+FD_RenderState::FD_RenderState(SDL_Renderer* renderer) : renderer{ renderer } {}
+FD_RenderState::~FD_RenderState() {}
+
+void FD_RenderState::invalidate() {
+	known_blend = false;
+	known_colour = false;
+	known_clip = false;
+	textures.clear();
+}
+
+void FD_RenderState::setDrawBlendMode(SDL_BlendMode blend) {
+	if (known_blend && this->blend == blend) {
+		skipped++;
+		return;
+	}
+	SDL_SetRenderDrawBlendMode(renderer, blend);
+	this->blend = blend;
+	known_blend = true;
+	issued++;
+}
+void FD_RenderState::setDrawColour(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+	if (known_colour && colour.r == r && colour.g == g && colour.b == b && colour.a == a) {
+		skipped++;
+		return;
+	}
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+	colour = { r, g, b, a };
+	known_colour = true;
+	issued++;
+}
+void FD_RenderState::setClipRect(const SDL_Rect* clip) {
+	if (known_clip && clipping == (clip != nullptr) && (clip == nullptr
+		|| (this->clip.x == clip->x && this->clip.y == clip->y
+		&& this->clip.w == clip->w && this->clip.h == clip->h))) {
+		skipped++;
+		return;
+	}
+	SDL_RenderSetClipRect(renderer, clip);
+	clipping = (clip != nullptr);
+	if (clipping) this->clip = *clip;
+	known_clip = true;
+	issued++;
+}
+void FD_RenderState::setTextureBlendMode(SDL_Texture* texture, SDL_BlendMode blend) {
+	TextureState& t{ textures[texture] };
+	if (t.known_blend && t.blend == blend) {
+		skipped++;
+		return;
+	}
+	SDL_SetTextureBlendMode(texture, blend);
+	t.blend = blend;
+	t.known_blend = true;
+	issued++;
+}
+void FD_RenderState::setTextureAlphaMod(SDL_Texture* texture, Uint8 alpha) {
+	TextureState& t{ textures[texture] };
+	if (t.known_alpha && t.alpha == alpha) {
+		skipped++;
+		return;
+	}
+	SDL_SetTextureAlphaMod(texture, alpha);
+	t.alpha = alpha;
+	t.known_alpha = true;
+	issued++;
+}
+void FD_RenderState::setTextureColourMod(SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b) {
+	TextureState& t{ textures[texture] };
+	if (t.known_colour && t.r == r && t.g == g && t.b == b) {
+		skipped++;
+		return;
+	}
+	SDL_SetTextureColorMod(texture, r, g, b);
+	t.r = r;
+	t.g = g;
+	t.b = b;
+	t.known_colour = true;
+	issued++;
+}
+
+SDL_Renderer* FD_RenderState::getRenderer() const { return renderer; }
+Uint64 FD_RenderState::getIssuedCount() const { return issued; }
+Uint64 FD_RenderState::getSkippedCount() const { return skipped; }
@@ -0,0 +1,122 @@
+#ifndef FD_RENDER_STATE_H_
+#define FD_RENDER_STATE_H_
+
+#include <unordered_map>
+
+#include <SDL_render.h>
+
+/*!
+	@file
+	@brief The file containing the FD_RenderState class.
+*/
+
+//! The class that caches the state of a renderer and its textures, only passing changes on to SDL.
+/*!
+	Each setter compares the value against the last one set through the cache
+	and, only calls SDL if it differs. Values are unknown until first set, so
+	the first call after construction or invalidate always reaches SDL.
+
+	The cache can't see state changed by other code or, textures destroyed and
+	recreated at the same address, so it should be invalidated before each pass
+	of drawing through it.
+
+	\sa FD_Window::getRenderState
+*/
+class FD_RenderState {
+private:
+
+	struct TextureState {
+		bool known_blend{ false };
+		bool known_alpha{ false };
+		bool known_colour{ false };
+		SDL_BlendMode blend{ SDL_BLENDMODE_NONE };
+		Uint8 alpha{ 255 };
+		Uint8 r{ 255 }, g{ 255 }, b{ 255 };
+	};
+
+	SDL_Renderer* renderer;
+
+	bool known_blend{ false };
+	SDL_BlendMode blend{ SDL_BLENDMODE_NONE };
+	bool known_colour{ false };
+	SDL_Colour colour{ 0, 0, 0, 0 };
+	bool known_clip{ false };
+	bool clipping{ false };
+	SDL_Rect clip{ };
+
+	std::unordered_map<SDL_Texture*, TextureState> textures{};
+
+	Uint64 issued{ 0 };
+	Uint64 skipped{ 0 };
+
+public:
+
+	//! Constructs a FD_RenderState.
+	/*!
+		\param renderer The renderer whose state is cached.
+	*/
+	FD_RenderState(SDL_Renderer* renderer);
+	//! Destroys the FD_RenderState.
+	~FD_RenderState();
+
+	//! Forgets every cached value, so the next of each is passed on to SDL.
+	void invalidate();
+
+	//! Sets the blend mode used to draw primitives.
+	/*!
+		\param blend The blend mode.
+	*/
+	void setDrawBlendMode(SDL_BlendMode blend);
+	//! Sets the colour used to draw primitives.
+	/*!
+		\param r The red component.
+		\param g The green component.
+		\param b The blue component.
+		\param a The alpha component.
+	*/
+	void setDrawColour(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+	//! Sets the clip rectangle.
+	/*!
+		\param clip The clip rectangle, or nullptr to disable clipping.
+	*/
+	void setClipRect(const SDL_Rect* clip);
+	//! Sets the blend mode of a texture.
+	/*!
+		\param texture The texture.
+		\param blend   The blend mode.
+	*/
+	void setTextureBlendMode(SDL_Texture* texture, SDL_BlendMode blend);
+	//! Sets the alpha modulation of a texture.
+	/*!
+		\param texture The texture.
+		\param alpha   The alpha modulation.
+	*/
+	void setTextureAlphaMod(SDL_Texture* texture, Uint8 alpha);
+	//! Sets the colour modulation of a texture.
+	/*!
+		\param texture The texture.
+		\param r       The red modulation.
+		\param g       The green modulation.
+		\param b       The blue modulation.
+	*/
+	void setTextureColourMod(SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b);
+
+	//! Returns the renderer whose state is cached.
+	/*!
+		\return The renderer.
+	*/
+	SDL_Renderer* getRenderer() const;
+	//! Returns the number of state changes passed on to SDL.
+	/*!
+		\return The number of state changes passed on to SDL.
+	*/
+	Uint64 getIssuedCount() const;
+	//! Returns the number of state changes skipped as they changed nothing.
+	/*!
+		\return The number of state changes skipped.
+	*/
+	Uint64 getSkippedCount() const;
+
+};
+
+#endif
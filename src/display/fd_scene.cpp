@@ -1,5 +1,7 @@
 #include "fd_scene.hpp"
 
+#include <algorithm>
+
 FD_Scene::FD_Scene(std::shared_ptr<FD_Window> window,
 	std::string settings_path) {
 	this->use_settings = true;
@@ -85,119 +87,172 @@ void FD_Scene::writeDisplaySettings() {
 }
 
 void FD_Scene::update() {
+	FD_PROFILE_ZONE("FD_Scene::update");
+	if (stats != nullptr) stats->setSection(currentID);
 	win->update();
 	if (win->hasUpdated()) writeDisplaySettings();
 	if (groups.find(currentID) != groups.end()) {
-		for (auto og : groups.at(currentID)) {
-			og->update();
+		std::vector<std::shared_ptr<FD_ObjectGroup>>& list{ groups.at(currentID) };
+		if (jobs != nullptr && list.size() > 1) {
+			// Update the objects of each group in parallel
+			FD_JobGroup job_group{};
+			for (auto og : list) {
+				jobs->run(job_group, [og, this]() { og->updateObjects(jobs); });
+			}
+			jobs->wait(job_group);
+		} else {
+			for (auto og : list) og->updateObjects(jobs);
+		}
+		for (auto og : list) {
+			og->deliverEvents();
+			og->updateCameras();
 		}
 	}
 	io->update();
 }
 
-void FD_Scene::prepareRenderProgress() {
-	render_progress.clear();
-	render_completion.clear();
-	render_minimals.clear();
-	if (groups.find(currentID) != groups.end()) {
-		for (auto og : groups.at(currentID)) {
-			render_progress.push_back(0);
-			render_completion.push_back(og->getSize() == 0);
-		}
+bool FD_Scene::isCurrent(const DrawOrder& order,
+	const std::vector<std::shared_ptr<FD_ObjectGroup>>& list) const {
+	if (order.groups.size() != list.size()) return false;
+	for (size_t g = 0; g < list.size(); g++) {
+		if (order.groups[g] != list[g].get()) return false;
+		if (order.revisions[g] != list[g]->getRevision()) return false;
 	}
+	return true;
 }
-bool FD_Scene::renderCompleted() {
-	for (bool b : render_completion) {
-		if (!b) return false;
+void FD_Scene::merge(DrawOrder& order, const std::vector<std::shared_ptr<FD_ObjectGroup>>& list) {
+	FD_PROFILE_ZONE("FD_Scene::merge");
+	order.groups.clear();
+	order.revisions.clear();
+	order.entries.clear();
+	merge_heap.clear();
+	// The heap gives the lowest layer first, then the earliest group, as each group is in layer order
+	auto later = [](const MergeCursor& a, const MergeCursor& b) {
+		return a.layer != b.layer ? a.layer > b.layer : a.group > b.group;
+	};
+	for (size_t g = 0; g < list.size(); g++) {
+		const std::shared_ptr<FD_ObjectGroup>& og{ list[g] };
+		order.groups.push_back(og.get());
+		order.revisions.push_back(og->getRevision());
+		int layer{ 0 };
+		if (og->getDrawCount() == 0 || !og->getLayer(og->getDrawIndex(0), layer)) continue;
+		merge_heap.push_back({ layer, static_cast<Uint32>(g), 0 });
+		std::push_heap(merge_heap.begin(), merge_heap.end(), later);
 	}
-	return true;
+	while (!merge_heap.empty()) {
+		std::pop_heap(merge_heap.begin(), merge_heap.end(), later);
+		MergeCursor& c{ merge_heap.back() };
+		const std::shared_ptr<FD_ObjectGroup>& og{ list[c.group] };
+		order.entries.push_back({ c.group, static_cast<Uint32>(og->getDrawIndex(c.position)) });
+		c.position++;
+		if (c.position < og->getDrawCount() && og->getLayer(og->getDrawIndex(c.position), c.layer)) {
+			std::push_heap(merge_heap.begin(), merge_heap.end(), later);
+		} else {
+			merge_heap.pop_back();
+		}
+	}
+}
+void FD_Scene::traverse(const std::function<void(const std::shared_ptr<FD_ObjectGroup>&,
+	size_t)>& visit) {
+	auto found = groups.find(currentID);
+	if (found == groups.end()) return;
+	const std::vector<std::shared_ptr<FD_ObjectGroup>>& list{ found->second };
+	// Merge the groups by layer again only if one has changed
+	DrawOrder& order{ draw_orders[currentID] };
+	if (!isCurrent(order, list)) merge(order, list);
+	for (const auto& entry : order.entries) visit(list[entry.first], entry.second);
 }
-void FD_Scene::render() {
-	SDL_SetRenderDrawColor(win->getRenderer(), 0, 0, 0, 255);
+void FD_Scene::render(double interpolation) {
+	FD_PROFILE_ZONE("FD_Scene::render");
+	auto phase_start{ std::chrono::high_resolution_clock::now() };
+	// Other code may have changed the renderer and its textures since the last frame
+	FD_RenderState& state{ win->getRenderState() };
+	state.invalidate();
+	state.setDrawColour(0, 0, 0, 255);
 	SDL_RenderClear(win->getRenderer());
-	// Render the current object list
-	if (groups.find(currentID) != groups.end()) {
-		// Prepare the camera
-		for (auto og : groups.at(currentID)) {
-			og->pre_render();
+	// Take the latest snapshot if one has been published
+	bool snapshot{ false };
+	{
+		std::lock_guard<std::mutex> lock{ snapshot_mutex };
+		snapshot = snapshotting;
+		if (fresh) {
+			presenting.clear();
+			presenting.swap(published);
+			fresh = false;
 		}
-		// Render the objects
-		prepareRenderProgress();
-		bool first_inspection{};
-		size_t index{};
-		int temp_minimal{}, minimal{};
-		while (!renderCompleted()) {
-			// index        : the index of the group we are looking at
-			// temp_minimal : the lowest layer of the current group
-			// Reset the index
-			index = 0;
-			first_inspection = true;
-			// Clear the 'groups with the minimal layer'
-			render_minimals.clear();
-			// Iterate through the groups...
+	}
+	const FD_RenderSnapshot* submitted{ &presenting };
+	if (!snapshot) {
+		// Record the current object list
+		frame.clear();
+		if (groups.find(currentID) != groups.end()) {
+			if (stats != nullptr) stats->setSection(currentID);
+			// Prepare the camera
 			for (auto og : groups.at(currentID)) {
-				// If the group is complete, ignore
-				if (render_completion.at(index)) {
-					index++;
-					continue;
-				}
-				// Get the minimal layer not get drawn
-				og->getLayer(render_progress.at(index), temp_minimal);
-				// Check if it's the smallest seen
-				if (first_inspection) {
-					// If it's the first group, it's always the smallest seen
-					minimal = temp_minimal;
-					render_minimals.push_back(index);
-					first_inspection = false;
-				} else {
-					if (temp_minimal < minimal) {
-						// This is a new low, reset the minimals
-						render_minimals.clear();
-						// Set the minimal and add this group to the minimals
-						minimal = temp_minimal;
-						render_minimals.push_back(index);
-					} else if (temp_minimal == minimal) {
-						// This is a shared low, add to the minimals
-						render_minimals.push_back(index);
-					}
-				}
-				index++;
-			}
-			// min_index    : the index of the group with the minimal
-			// index        : the index of the object we are looking to draw
-			// temp_minimal : the layer of the next object in this groups list
-			for (size_t min_index : render_minimals) {
-				// Get the object index
-				index = render_progress.at(min_index);
-				// The layer of the next object to be drawn is by
-				// definition, the minimal
-				temp_minimal = minimal;
-				// If we haven't completed this list and the next object is also minimal...
-				while (!render_completion.at(min_index) && temp_minimal == minimal) {
-					// Render the object
-					groups.at(currentID).at(min_index)->render(index, win->getRenderer());
-					// Increment our progress and our index
-					index++;
-					render_progress.at(min_index) = index;
-					// If our progress has reached the end of the list, we are complete
-					if (render_progress.at(min_index) ==
-						groups.at(currentID).at(min_index)->getSize()) {
-						render_completion.at(min_index) = true;
-					} else {
-						// Get the minimal of the next element for checking
-						groups.at(currentID).at(min_index)->getLayer(index, temp_minimal);
-					}
-				}
+				og->pre_render();
 			}
+			traverse([this, interpolation](const std::shared_ptr<FD_ObjectGroup>& og,
+				size_t index) {
+				og->record(index, frame, interpolation);
+			});
+			if (layer_sorting) frame.sort();
+		}
+		submitted = &frame;
+		if (stats != nullptr) {
+			auto now{ std::chrono::high_resolution_clock::now() };
+			stats->record(FD_PHASE_RENDER, now - phase_start);
+			phase_start = now;
 		}
 	}
+	// Draw the commands in one pass
+	submitted->execute(state, sprite_batching ? &sprites : nullptr,
+		primitive_batching ? &primitives : nullptr);
+	if (stats != nullptr) {
+		auto now{ std::chrono::high_resolution_clock::now() };
+		stats->record(FD_PHASE_SUBMIT, now - phase_start);
+		phase_start = now;
+	}
 	SDL_RenderPresent(win->getRenderer());
+	if (stats != nullptr) {
+		stats->record(FD_PHASE_PRESENT, std::chrono::high_resolution_clock::now() - phase_start);
+	}
+}
+
+void FD_Scene::publish() {
+	FD_PROFILE_ZONE("FD_Scene::publish");
+	recording.clear();
+	if (groups.find(currentID) != groups.end()) {
+		for (auto og : groups.at(currentID)) {
+			og->pre_render();
+		}
+		traverse([this](const std::shared_ptr<FD_ObjectGroup>& og, size_t index) {
+			og->record(index, recording);
+		});
+		if (layer_sorting) recording.sort();
+	}
+	// Hand the snapshot over, replacing any that wasn't drawn
+	std::lock_guard<std::mutex> lock{ snapshot_mutex };
+	published.swap(recording);
+	fresh = true;
+	snapshotting = true;
+}
+
+void FD_Scene::stopPublishing() {
+	std::lock_guard<std::mutex> lock{ snapshot_mutex };
+	snapshotting = false;
+	fresh = false;
+	published.clear();
+	presenting.clear();
 }
 
 void FD_Scene::pushEvent(const SDL_Event* e) {
-	if (e->type == SDL_WINDOWEVENT) win->pushEvent(e->window);
 	io->pushEvent(e);
 }
+void FD_Scene::pushWindowEvent(const SDL_Event* e) {
+	if (e->type == SDL_WINDOWEVENT) win->pushEvent(e->window);
+}
+bool FD_Scene::hasRenderTasks() const { return win->hasRenderTasks(); }
+void FD_Scene::runRenderTasks() { win->runRenderTasks(); }
 
 FD_ObjListIndex FD_Scene::generateObjectList() {
 	groups[++objectIDCount]
@@ -215,13 +270,37 @@ void FD_Scene::addObjectGroup(const std::shared_ptr<FD_ObjectGroup> og) {
 }
 void FD_Scene::removeObjectGroup(const std::shared_ptr<FD_ObjectGroup> og) {
 	if (groups.find(og->getID()) != groups.end()) {
-		auto v{ groups.at(og->getID()) };
+		auto& v{ groups.at(og->getID()) };
 		if (std::find(v.begin(), v.end(), og) != v.end()) {
 			v.erase(std::find(v.begin(), v.end(), og));
 		}
 	}
 }
 
+void FD_Scene::setLayerSorting(bool sorting) {
+	this->layer_sorting = sorting;
+}
+bool FD_Scene::isLayerSorting() const { return layer_sorting; }
+void FD_Scene::setSpriteBatching(bool batching) {
+	this->sprite_batching = batching;
+}
+bool FD_Scene::isSpriteBatching() const { return sprite_batching; }
+const FD_SpriteBatch& FD_Scene::getSpriteBatch() const { return sprites; }
+void FD_Scene::setPrimitiveBatching(bool batching) {
+	this->primitive_batching = batching;
+}
+bool FD_Scene::isPrimitiveBatching() const { return primitive_batching; }
+const FD_PrimitiveBatch& FD_Scene::getPrimitiveBatch() const { return primitives; }
+
+void FD_Scene::setJobSystem(std::shared_ptr<FD_JobSystem> jobs) {
+	this->jobs = jobs;
+}
+std::shared_ptr<FD_JobSystem> FD_Scene::getJobSystem() const { return jobs; }
+
+void FD_Scene::setFrameStats(std::shared_ptr<FD_FrameStats> stats) {
+	this->stats = stats;
+}
+
 std::shared_ptr<FD_IOManager> FD_Scene::getIOManager() const {
 	return io;
 }
@@ -1,19 +1,27 @@
 #ifndef FD_SCENE_H_
 #define FD_SCENE_H_
 
+#include <mutex>
 #include <memory>
 #include <vector>
+#include <functional>
 #include <unordered_map>
 
 #include <SDL_video.h>
 
 #include "fd_camera.hpp"
 #include "fd_window.hpp"
+#include "fd_renderSnapshot.hpp"
+#include "fd_spriteBatch.hpp"
+#include "fd_primitiveBatch.hpp"
 #include "../display/fd_resizable.hpp"
 #include "../input/fd_ioManager.hpp"
 #include "../input/fd_paths.hpp"
 #include "../object/fd_objectGroup.hpp"
 #include "../main/fd_handling.hpp"
+#include "../main/fd_profiler.hpp"
+#include "../main/fd_jobSystem.hpp"
+#include "../main/fd_frameStats.hpp"
 
 /*!
 	@file
@@ -57,11 +65,41 @@ private:
 	void readDisplaySettings();
 	void writeDisplaySettings();
 
-	std::vector<size_t> render_progress{};
-	std::vector<size_t> render_minimals{};
-	std::vector<bool> render_completion{};
-	void prepareRenderProgress();
-	bool renderCompleted();
+	std::shared_ptr<FD_FrameStats> stats{ nullptr };
+	std::shared_ptr<FD_JobSystem> jobs{ nullptr };
+
+	// The objects of an object list in drawing order, kept until a group changes
+	struct DrawOrder {
+		std::vector<const FD_ObjectGroup*> groups{};
+		std::vector<Uint64> revisions{};
+		std::vector<std::pair<Uint32, Uint32>> entries{};
+	};
+	struct MergeCursor {
+		int layer;
+		Uint32 group;
+		Uint32 position;
+	};
+	std::unordered_map<FD_ObjListIndex, DrawOrder> draw_orders{};
+	std::vector<MergeCursor> merge_heap{};
+	bool isCurrent(const DrawOrder& order,
+		const std::vector<std::shared_ptr<FD_ObjectGroup>>& list) const;
+	void merge(DrawOrder& order, const std::vector<std::shared_ptr<FD_ObjectGroup>>& list);
+	void traverse(const std::function<void(const std::shared_ptr<FD_ObjectGroup>&,
+		size_t)>& visit);
+
+	std::mutex snapshot_mutex;
+	bool snapshotting{ false };
+	bool fresh{ false };
+	FD_RenderSnapshot recording{};
+	FD_RenderSnapshot published{};
+	FD_RenderSnapshot presenting{};
+	// The commands of the frame being drawn without snapshots
+	FD_RenderSnapshot frame{};
+	bool layer_sorting{ false };
+	FD_SpriteBatch sprites{};
+	bool sprite_batching{ false };
+	FD_PrimitiveBatch primitives{};
+	bool primitive_batching{ true };
 
 public:
 
@@ -96,12 +134,64 @@ public:
 	*/
 	void update();
 	//! Renders the instances of FD_Object to the FD_Window.
-	void render();
+	/*!
+		The current object list is recorded to a flat list of draw commands,
+		which are then drawn in one pass. Once a snapshot has been published,
+		the latest snapshot is drawn instead of the objects themselves, until
+		stopPublishing is called.
+
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
+
+		\sa publish
+	*/
+	void render(double interpolation = 1);
+	//! Records the current object list to a snapshot for render to draw.
+	/*!
+		This allows the scene to be updated on one thread and drawn on another,
+		as render then only reads the snapshot. The snapshot holds the objects as
+		they are when published, so interpolation is not applied to it.
+
+		\warning Once called, render no longer draws the objects directly
+		until stopPublishing is called.
+
+		\sa FD_RenderSnapshot
+	*/
+	void publish();
+	//! Has render draw the objects directly again, dropping any published snapshot.
+	/*!
+		This should be called on the thread that renders once nothing is
+		publishing.
+
+		\sa publish
+	*/
+	void stopPublishing();
 	//! Pushes events to the classes associated to the FD_Scene.
 	/*!
 		\param e The event to be parsed.
 	*/
 	void pushEvent(const SDL_Event* e);
+	//! Pushes a window event to the window, resizing its resizables.
+	/*!
+		This should be called on the thread that renders, as resizables may
+		remake their textures. Window events are still given to pushEvent.
+
+		\param e The window event to be parsed.
+
+		\sa FD_Loopable::pushWindowEvent
+	*/
+	void pushWindowEvent(const SDL_Event* e);
+	//! Returns whether the window has tasks queued for the thread that renders.
+	/*!
+		\return Whether runRenderTasks has anything to run.
+
+		\sa FD_Window::runOnRenderThread
+	*/
+	bool hasRenderTasks() const;
+	//! Runs the tasks the window has queued for the thread that renders.
+	/*!
+		\sa FD_Window::runRenderTasks
+	*/
+	void runRenderTasks();
 
 	//! Generates a new index for registering instances of FD_ObjectGroup.
 	/*!
@@ -135,6 +225,90 @@ public:
 	*/
 	void removeObjectGroup(const std::shared_ptr<FD_ObjectGroup> og);
 
+	//! Sets the job system used to update the object groups in parallel.
+	/*!
+		The objects of each group of the current object list are updated in
+		parallel, followed by their camera sets in order. Objects should then
+		only be added to a single group.
+
+		\param jobs The job system to use, or nullptr to update serially.
+
+		\sa FD_JobSystem
+	*/
+	void setJobSystem(std::shared_ptr<FD_JobSystem> jobs);
+	//! Sets whether the draw commands of each layer are sorted by texture, blend mode and, clip rectangle.
+	/*!
+		Sorting reduces renderer state changes and allows batching, but objects
+		in the same layer that overlap may then be drawn in a different order,
+		so this is off by default.
+
+		\param sorting Whether the draw commands of each layer are sorted.
+
+		\sa FD_RenderSnapshot::sort
+	*/
+	void setLayerSorting(bool sorting);
+	//! Returns whether the draw commands of each layer are sorted.
+	/*!
+		\return Whether the draw commands of each layer are sorted.
+	*/
+	bool isLayerSorting() const;
+	//! Sets whether consecutive images sharing a texture, blend mode and, clip rectangle are drawn together.
+	/*!
+		Batched images are drawn through SDL_RenderGeometry instead of
+		SDL_RenderCopyEx, which rasterises their edges slightly differently,
+		so this is off by default. It has no effect before SDL 2.0.18. Layer
+		sorting makes such images consecutive more often.
+
+		\param batching Whether images are batched.
+
+		\sa FD_SpriteBatch
+	*/
+	void setSpriteBatching(bool batching);
+	//! Returns whether images are batched.
+	/*!
+		\return Whether images are batched.
+	*/
+	bool isSpriteBatching() const;
+	//! Returns the sprite batch images are drawn through.
+	/*!
+		\return The sprite batch.
+	*/
+	const FD_SpriteBatch& getSpriteBatch() const;
+	//! Sets whether consecutive lines and boxes sharing a blend mode and, clip rectangle are drawn together.
+	/*!
+		This is on by default.
+
+		\param batching Whether lines and boxes are batched.
+
+		\sa FD_PrimitiveBatch
+	*/
+	void setPrimitiveBatching(bool batching);
+	//! Returns whether lines and boxes are batched.
+	/*!
+		\return Whether lines and boxes are batched.
+	*/
+	bool isPrimitiveBatching() const;
+	//! Returns the batch lines and boxes are drawn through.
+	/*!
+		\return The primitive batch.
+	*/
+	const FD_PrimitiveBatch& getPrimitiveBatch() const;
+	//! Returns the job system used to update the object groups, which states may also use.
+	/*!
+		\return The job system, or nullptr if there is none.
+	*/
+	std::shared_ptr<FD_JobSystem> getJobSystem() const;
+	//! Sets the statistics that the durations of the render, submit and, present phases are recorded to.
+	/*!
+		The section of the statistics is set to the current object list on
+		every update and render.
+
+		\param stats The statistics to record to, or nullptr to stop recording.
+
+		\sa FD_FrameStats
+	*/
+	void setFrameStats(std::shared_ptr<FD_FrameStats> stats);
+
 	//! Returns the FD_IOManager.
 	/*!
 		\return The FD_IOManager.
@@ -0,0 +1,94 @@
+#include "fd_spriteBatch.hpp"
+
+#include <cmath>
+#include <utility>
+
+FD_SpriteBatch::FD_SpriteBatch() {}
+FD_SpriteBatch::~FD_SpriteBatch() {}
+
+bool FD_SpriteBatch::add(FD_RenderState& state, const FD_Image& image, Uint8 alpha,
+	const SDL_Rect* srcrect, const SDL_Rect& dstrect,
+	double angle, double center_x, double center_y, SDL_RendererFlip flip,
+	SDL_BlendMode blend, const SDL_Rect* clip) {
+#ifndef FD_SPRITE_BATCHING
+	return false;
+#else
+	// Images that wouldn't be drawn need nothing doing
+	SDL_Texture* t{ image.getTexture() };
+	if (!image.isLoaded() || t == nullptr || alpha == 0) return true;
+	if (!image.isBatchable()) return false;
+	if (image.getTextureWidth() == 0 || image.getTextureHeight() == 0) return false;
+	// Images in an atlas are drawn from their area of it
+	SDL_Rect source{ image.getSourceRect(srcrect) };
+	if (source.w <= 0 || source.h <= 0) return true;
+	// Draw the batch if the sprite doesn't share its state
+	bool clipping{ clip != nullptr };
+	if (quads > 0 && (t != texture || blend != this->blend || clipping != has_clip
+		|| (clipping && (clip->x != this->clip.x || clip->y != this->clip.y
+		|| clip->w != this->clip.w || clip->h != this->clip.h))
+		|| quads == max_quads)) {
+		flush(state);
+	}
+	if (quads == 0) {
+		texture = t;
+		this->blend = blend;
+		has_clip = clipping;
+		if (clipping) this->clip = *clip;
+	}
+	// Rotate the corners about the center, as SDL_RenderCopyEx does
+	SDL_Rect rect{ image.getExtrusion() > 0 ? FD_Maths::extrude(dstrect, image.getExtrusion()) : dstrect };
+	int cx{ static_cast<int>(center_x * dstrect.w) };
+	int cy{ static_cast<int>(center_y * dstrect.h) };
+	float px{ static_cast<float>(rect.x + cx) }, py{ static_cast<float>(rect.y + cy) };
+	float x0{ static_cast<float>(-cx) }, x1{ static_cast<float>(rect.w - cx) };
+	float y0{ static_cast<float>(-cy) }, y1{ static_cast<float>(rect.h - cy) };
+	float c{ 1 }, s{ 0 };
+	if (angle != 0) {
+		c = static_cast<float>(std::cos(angle * FD_PI / 180.0));
+		s = static_cast<float>(std::sin(angle * FD_PI / 180.0));
+	}
+	// Map the source rectangle onto the texture, flipping if needed
+	float w{ static_cast<float>(image.getTextureWidth()) };
+	float h{ static_cast<float>(image.getTextureHeight()) };
+	float u0{ source.x / w }, u1{ (source.x + source.w) / w };
+	float v0{ source.y / h }, v1{ (source.y + source.h) / h };
+	if (flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+	if (flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+	// SDL_RenderGeometry ignores the texture's colour mod, so carry it in the vertices
+	Uint8 r{ 255 }, g{ 255 }, b{ 255 };
+	SDL_GetTextureColorMod(t, &r, &g, &b);
+	const SDL_Colour colour{ r, g, b, alpha };
+	auto corner = [&](float x, float y, float u, float v) {
+		vertices.push_back({ { px + x * c - y * s, py + x * s + y * c }, colour, { u, v } });
+	};
+	corner(x0, y0, u0, v0);
+	corner(x1, y0, u1, v0);
+	corner(x1, y1, u1, v1);
+	corner(x0, y1, u0, v1);
+	quads++;
+	sprites++;
+	return true;
+#endif
+}
+void FD_SpriteBatch::flush(FD_RenderState& state) {
+	if (quads == 0) return;
+#ifdef FD_SPRITE_BATCHING
+	// Every quad is indexed the same way, so the indices are only ever extended
+	while (indices.size() < quads * 6) {
+		int first{ static_cast<int>(indices.size() / 6 * 4) };
+		for (int i : { 0, 1, 2, 0, 2, 3 }) indices.push_back(first + i);
+	}
+	state.setClipRect(has_clip ? &clip : nullptr);
+	state.setTextureBlendMode(texture, blend);
+	// The opacity is carried by the vertices instead
+	state.setTextureAlphaMod(texture, 255);
+	SDL_RenderGeometry(state.getRenderer(), texture, vertices.data(),
+		static_cast<int>(vertices.size()), indices.data(), static_cast<int>(quads * 6));
+	vertices.clear();
+	calls++;
+#endif
+	quads = 0;
+}
+
+Uint64 FD_SpriteBatch::getSpriteCount() const { return sprites; }
+Uint64 FD_SpriteBatch::getCallCount() const { return calls; }
@@ -0,0 +1,106 @@
+#ifndef FD_SPRITE_BATCH_H_
+#define FD_SPRITE_BATCH_H_
+
+#include <vector>
+
+#include <SDL_render.h>
+#include <SDL_version.h>
+
+#include "fd_renderState.hpp"
+#include "../input/fd_imageManager.hpp"
+
+/*!
+	@file
+	@brief The file containing the FD_SpriteBatch class.
+*/
+
+// SDL_RenderGeometry was added in SDL 2.0.18
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+//! Defined when sprites can be batched through SDL_RenderGeometry.
+#define FD_SPRITE_BATCHING
+#endif
+
+//! The class that collects consecutive sprites sharing a texture, blend mode and clip rectangle into one draw call.
+/*!
+	Each sprite is turned into a quad on the CPU, rotated and flipped as
+	SDL_RenderCopyEx would and, with its opacity and the texture's colour
+	mod in the colour of its vertices. The quads are drawn together by SDL_RenderGeometry when a
+	sprite that can't join them is added or, the batch is flushed.
+
+	Images that aren't batchable, such as those with an underlay or overlay
+	colour, are left to FD_Image::render. Without SDL 2.0.18, nothing is
+	batched.
+
+	The quads are rasterised as geometry rather than copies, so edges and
+	rotated sprites may differ from SDL_RenderCopyEx by a pixel.
+
+	\sa FD_RenderSnapshot::execute, FD_Image::isBatchable
+*/
+class FD_SpriteBatch {
+private:
+
+#ifdef FD_SPRITE_BATCHING
+	std::vector<SDL_Vertex> vertices{};
+	std::vector<int> indices{};
+#endif
+	SDL_Texture* texture{ nullptr };
+	SDL_BlendMode blend{ SDL_BLENDMODE_NONE };
+	bool has_clip{ false };
+	SDL_Rect clip{ };
+	size_t quads{ 0 };
+
+	Uint64 sprites{ 0 };
+	Uint64 calls{ 0 };
+
+public:
+
+	//! The most quads drawn by one call.
+	static const size_t max_quads{ 8192 };
+
+	//! Constructs a FD_SpriteBatch.
+	FD_SpriteBatch();
+	//! Destroys the FD_SpriteBatch.
+	~FD_SpriteBatch();
+
+	//! Adds a sprite to the batch, drawing the batch first if the sprite can't join it.
+	/*!
+		The parameters are as in FD_Image::render, except that a destination is required.
+
+		\param state    The cache of the state of the renderer to draw with.
+		\param image    The image of the sprite.
+		\param alpha    The alpha of the sprite.
+		\param srcrect  The source rectangle of the image, or nullptr for the whole image.
+		\param dstrect  The destination rectangle of the sprite.
+		\param angle    The angle of the sprite.
+		\param center_x The x center of the sprite, in units of the destination's width.
+		\param center_y The y center of the sprite, in units of the destination's height.
+		\param flip     The flip flags of the sprite.
+		\param blend    The blend mode of the sprite.
+		\param clip     The clip rectangle of the sprite, or nullptr.
+
+		\return Whether the sprite was handled, if not it should be drawn by FD_Image::render after flushing.
+	*/
+	bool add(FD_RenderState& state, const FD_Image& image, Uint8 alpha,
+		const SDL_Rect* srcrect, const SDL_Rect& dstrect,
+		double angle, double center_x, double center_y, SDL_RendererFlip flip,
+		SDL_BlendMode blend, const SDL_Rect* clip);
+	//! Draws and empties the batch.
+	/*!
+		\param state The cache of the state of the renderer to draw with.
+	*/
+	void flush(FD_RenderState& state);
+
+	//! Returns the number of sprites batched so far.
+	/*!
+		\return The number of sprites batched.
+	*/
+	Uint64 getSpriteCount() const;
+	//! Returns the number of draw calls the batched sprites took.
+	/*!
+		\return The number of draw calls.
+	*/
+	Uint64 getCallCount() const;
+
+};
+
+#endif
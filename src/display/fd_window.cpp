@@ -18,6 +18,7 @@ FD_Window::FD_Window(std::string title, int width, int height,
 		FD_Handling::errorSDL("A renderer could not be initialised.");
 		FD_Handling::error("Fatal SDL error.", true);
 	}
+	state = std::make_unique<FD_RenderState>(renderer);
 	FD_Handling::debug("SDL_Renderer initialised...");
 	// Set flags
 	if (win_flags & SDL_WINDOW_FULLSCREEN 
@@ -42,8 +43,14 @@ void FD_Window::pushEvent(SDL_WindowEvent e) {
 	switch (e.event) {
 	case SDL_WINDOWEVENT_RESTORED:
 	case SDL_WINDOWEVENT_MAXIMIZED:
-	case SDL_WINDOWEVENT_SIZE_CHANGED:
-		for (auto r : resizeables) {
+	case SDL_WINDOWEVENT_SIZE_CHANGED: {
+		// Resize a copy, so that resizables can be added whilst resizing
+		std::vector<std::shared_ptr<FD_Resizable>> current{};
+		{
+			std::lock_guard<std::mutex> lock{ resizeable_mutex };
+			current = resizeables;
+		}
+		for (auto r : current) {
 			if (fullscreen) {
 				r->resized(getScreenWidth(), getScreenHeight());
 			} else {
@@ -52,10 +59,12 @@ void FD_Window::pushEvent(SDL_WindowEvent e) {
 		}
 		break;
 	}
+	}
 }
 
 void FD_Window::update() {
 	// Clear unnecessary pointers from the resizables
+	std::lock_guard<std::mutex> lock{ resizeable_mutex };
 	auto it{ resizeables.begin() };
 	while (it != resizeables.end()) {
 		if ((*it).use_count() == 1) {
@@ -82,9 +91,31 @@ void FD_Window::apply() {
 }
 
 void FD_Window::addResizable(std::shared_ptr<FD_Resizable> resizeable) {
+	std::lock_guard<std::mutex> lock{ resizeable_mutex };
 	this->resizeables.push_back(resizeable);
 }
 
+void FD_Window::runOnRenderThread(std::function<void()> task) {
+	if (std::this_thread::get_id() == render_thread) {
+		task();
+		return;
+	}
+	std::lock_guard<std::mutex> lock{ task_mutex };
+	render_tasks.push_back(std::move(task));
+	tasks_pending = true;
+}
+bool FD_Window::hasRenderTasks() const { return tasks_pending; }
+void FD_Window::runRenderTasks() {
+	if (!tasks_pending) return;
+	std::vector<std::function<void()>> tasks{};
+	{
+		std::lock_guard<std::mutex> lock{ task_mutex };
+		tasks.swap(render_tasks);
+		tasks_pending = false;
+	}
+	for (auto& task : tasks) task();
+}
+
 void FD_Window::setFullscreen() {
 	this->fullscreen = true;
 	apply();
@@ -113,6 +144,9 @@ bool FD_Window::hasUpdated() {
 SDL_Renderer* FD_Window::getRenderer() const {
 	return renderer;
 }
+FD_RenderState& FD_Window::getRenderState() const {
+	return *state;
+}
 bool FD_Window::isFullscreen() const {
 	return fullscreen;
 }
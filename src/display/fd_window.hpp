@@ -1,15 +1,20 @@
 #ifndef FD_WINDOW_H_
 #define FD_WINDOW_H_
 
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <string>
+#include <functional>
 
 #include <SDL_hints.h>
 #include <SDL_events.h>
 #include <SDL_render.h>
 
 #include "fd_resizable.hpp"
+#include "fd_renderState.hpp"
 #include "../main/fd_handling.hpp"
 
 /*!
@@ -27,9 +32,16 @@ private:
 
 	SDL_Window* window;
 	SDL_Renderer* renderer;
+	std::unique_ptr<FD_RenderState> state{ nullptr };
 
+	std::mutex resizeable_mutex;
 	std::vector<std::shared_ptr<FD_Resizable>> resizeables{};
 
+	const std::thread::id render_thread{ std::this_thread::get_id() };
+	std::mutex task_mutex;
+	std::vector<std::function<void()>> render_tasks{};
+	std::atomic<bool> tasks_pending{ false };
+
 	void apply();
 
 public:
@@ -64,12 +76,36 @@ public:
 
 	//! Adds an FD_Resizable.
 	/*!
+		This can be called from any thread.
+
 		\param resizable The FD_Resizable to add.
 
 		\sa FD_Resizable
 	*/
 	void addResizable(std::shared_ptr<FD_Resizable> resizable);
 
+	//! Runs a task that uses the renderer on the thread that made the window.
+	/*!
+		On that thread the task is ran immediately, otherwise it is queued for
+		runRenderTasks. Tasks queued by a separate update thread are ran
+		whilst no update runs, so they may change objects as well.
+
+		\param task The task to run.
+
+		\sa FD_Looper::setThreadedUpdate
+	*/
+	void runOnRenderThread(std::function<void()> task);
+	//! Returns whether there are tasks queued for the thread that made the window.
+	/*!
+		\return Whether runRenderTasks has anything to run.
+	*/
+	bool hasRenderTasks() const;
+	//! Runs the tasks queued for the thread that made the window, in the order they were queued.
+	/*!
+		This should be called on the thread that made the window.
+	*/
+	void runRenderTasks();
+
 	//! Makes the window fullscreen.
 	void setFullscreen();
 	//! Makes the window windowed.
@@ -102,6 +138,15 @@ public:
 		\return The renderer.
 	*/
 	SDL_Renderer* getRenderer() const;
+	//! Returns the cache of the renderer's state.
+	/*!
+		Drawing through the cache skips SDL calls that would change nothing.
+
+		\return The cache of the renderer's state.
+
+		\sa FD_RenderState
+	*/
+	FD_RenderState& getRenderState() const;
 	//! Returns whether the window is fullscreen or not.
 	/*!
 		\return Whether the window is fullscreen or not.
@@ -12,7 +12,8 @@ std::shared_ptr<FD_ObjectGroup> FD_Factory::lockGroup() {
 	return group;
 }
 
-FD_Factory::FD_Factory(std::weak_ptr<FD_Scene> scene) : scene{ scene } {}
+FD_Factory::FD_Factory(std::weak_ptr<FD_Scene> scene,
+	std::shared_ptr<FD_ObjectArena> arena) : scene{ scene }, arena{ arena } {}
 FD_Factory::~FD_Factory() {}
 
 std::shared_ptr<FD_CameraSet> FD_Factory::generateCameraSet() {
@@ -90,7 +91,7 @@ std::shared_ptr<FD_Element> FD_Factory::generateElement(
 	double x, double y, double angle, int z, 
 	double scale, double scale_y, bool camera_bound, FD_DrawStyle style) {
 	std::shared_ptr<FD_Element> element{
-		std::make_shared<FD_Element>(
+		this->make<FD_Element>(
 			image, x, y, angle, z, scale, scale_y, camera_bound, style
 		)
 	};
@@ -102,7 +103,7 @@ std::shared_ptr<FD_Box> FD_Factory::generateBox(bool configure,
 	double x, double y, double w, double h, int z, 
 	bool camera_bound, SDL_Colour colour) {
 	std::shared_ptr<FD_Box> box{
-		std::make_shared<FD_Box>(x, y, w, h, z, camera_bound, colour)
+		this->make<FD_Box>(x, y, w, h, z, camera_bound, colour)
 	};
 	if (configure) this->configure(box);
 	return box;
@@ -112,7 +113,7 @@ std::shared_ptr<FD_Line> FD_Factory::generateLine(bool configure,
 		double x1, double y1, double x2, double y2, int z, 
 		bool camera_bound, SDL_Colour colour) {
 	std::shared_ptr<FD_Line> line{
-		std::make_shared<FD_Line>(x1, y1, x2, y2, z, camera_bound, colour)
+		this->make<FD_Line>(x1, y1, x2, y2, z, camera_bound, colour)
 	};
 	if (configure) this->configure(line);
 	return line;
@@ -141,3 +142,6 @@ void FD_Factory::configure(std::shared_ptr<FD_Object> o) {
 void FD_Factory::setGroup(std::weak_ptr<FD_ObjectGroup> group) {
 	this->group = group;
 }
+void FD_Factory::setArena(std::shared_ptr<FD_ObjectArena> arena) {
+	this->arena = arena;
+}
@@ -6,6 +6,7 @@
 #include "../display/fd_scene.hpp"
 #include "../object/fd_object.hpp"
 #include "../object/fd_element.hpp"
+#include "../object/fd_objectArena.hpp"
 #include "../object/ui/fd_text.hpp"
 #include "../object/ui/fd_textField.hpp"
 #include "../object/ui/fd_buttonManager.hpp"
@@ -21,17 +22,25 @@ private:
 
 	std::weak_ptr<FD_Scene> scene;
 	std::weak_ptr<FD_ObjectGroup> group{ };
+	std::shared_ptr<FD_ObjectArena> arena{ };
 
 	std::shared_ptr<FD_Scene> lockScene();
 	std::shared_ptr<FD_ObjectGroup> lockGroup();
 
+	template <class T, class... Args>
+	std::shared_ptr<T> make(Args&&... args) {
+		if (arena == nullptr) return std::make_shared<T>(std::forward<Args>(args)...);
+		return std::allocate_shared<T>(FD_ArenaAllocator<T>{ arena }, std::forward<Args>(args)...);
+	}
+
 public:
 
 	//! Constructs an FD_Factory.
 	/*!
 		\param scene The scene for the factory to use.
+		\param arena The arena to allocate elements, boxes and, lines from, or nullptr to use the heap.
 	*/
-	FD_Factory(std::weak_ptr<FD_Scene> scene);
+	FD_Factory(std::weak_ptr<FD_Scene> scene, std::shared_ptr<FD_ObjectArena> arena = nullptr);
 	//! Destroys the FD_Factory.
 	~FD_Factory();
 
@@ -189,6 +198,13 @@ public:
 
 	//! Sets the current group the factory is using
 	void setGroup(std::weak_ptr<FD_ObjectGroup> group);
+	//! Sets the arena elements, boxes and, lines are allocated from.
+	/*!
+		\param arena The arena, or nullptr to use the heap.
+
+		\sa FD_State::getArena
+	*/
+	void setArena(std::shared_ptr<FD_ObjectArena> arena);
 
 };
 
@@ -0,0 +1,108 @@
+#include "fd_atlasPacker.hpp"
+
+FD_AtlasPacker::FD_AtlasPacker(int width, int height)
+	: width{ width > 0 ? width : 0 }, height{ height > 0 ? height : 0 } {
+	clear();
+}
+FD_AtlasPacker::~FD_AtlasPacker() {}
+
+std::vector<FD_AtlasPacker> FD_AtlasPacker::packPages(int width, int height,
+	const std::vector<SDL_Rect>& sizes, std::vector<size_t>& pages,
+	std::vector<SDL_Rect>& placed) {
+	std::vector<FD_AtlasPacker> packers{};
+	pages.assign(sizes.size(), size_t{ unpacked });
+	placed.assign(sizes.size(), { 0, 0, 0, 0 });
+	for (size_t i = 0; i < sizes.size(); i++) {
+		int w{ sizes[i].w }, h{ sizes[i].h };
+		if (w > width || h > height) continue;
+		for (size_t page = 0; page < packers.size(); page++) {
+			if (packers[page].insert(w, h, placed[i])) {
+				pages[i] = page;
+				break;
+			}
+		}
+		if (pages[i] == unpacked) {
+			packers.emplace_back(width, height);
+			packers.back().insert(w, h, placed[i]);
+			pages[i] = packers.size() - 1;
+		}
+	}
+	return packers;
+}
+
+// Finds the lowest a rectangle can sit with its left edge on a node
+bool FD_AtlasPacker::fit(size_t index, int w, int h, int& y) const {
+	if (skyline[index].x + w > width) return false;
+	y = 0;
+	int remaining{ w };
+	for (size_t i = index; remaining > 0; i++) {
+		if (i == skyline.size()) return false;
+		if (skyline[i].y > y) y = skyline[i].y;
+		if (y + h > height) return false;
+		remaining -= skyline[i].w;
+	}
+	return true;
+}
+
+bool FD_AtlasPacker::insert(int w, int h, SDL_Rect& placed) {
+	if (w <= 0 || h <= 0) return false;
+	// Find the lowest top, then the least covered width
+	size_t best{ skyline.size() };
+	int best_top{ 0 }, best_width{ 0 }, best_y{ 0 };
+	for (size_t i = 0; i < skyline.size(); i++) {
+		int y{ 0 };
+		if (!fit(i, w, h, y)) continue;
+		if (best == skyline.size() || y + h < best_top
+			|| (y + h == best_top && skyline[i].w < best_width)) {
+			best = i;
+			best_top = y + h;
+			best_width = skyline[i].w;
+			best_y = y;
+		}
+	}
+	if (best == skyline.size()) return false;
+	placed = { skyline[best].x, best_y, w, h };
+	// Raise the skyline under the rectangle
+	skyline.insert(skyline.begin() + best, { placed.x, placed.y + h, w });
+	size_t i{ best + 1 };
+	while (i < skyline.size()) {
+		Node& previous{ skyline[i - 1] };
+		Node& node{ skyline[i] };
+		if (node.x >= previous.x + previous.w) break;
+		int shrink{ previous.x + previous.w - node.x };
+		if (shrink < node.w) {
+			node.x += shrink;
+			node.w -= shrink;
+			break;
+		}
+		skyline.erase(skyline.begin() + i);
+	}
+	// Join neighbours at the same height
+	for (i = 1; i < skyline.size();) {
+		if (skyline[i - 1].y == skyline[i].y) {
+			skyline[i - 1].w += skyline[i].w;
+			skyline.erase(skyline.begin() + i);
+		} else {
+			i++;
+		}
+	}
+	if (placed.x + w > used_width) used_width = placed.x + w;
+	if (placed.y + h > used_height) used_height = placed.y + h;
+	used_area += static_cast<Uint64>(w) * h;
+	return true;
+}
+void FD_AtlasPacker::clear() {
+	skyline.clear();
+	if (width > 0) skyline.push_back({ 0, 0, width });
+	used_width = used_height = 0;
+	used_area = 0;
+}
+
+int FD_AtlasPacker::getWidth() const { return width; }
+int FD_AtlasPacker::getHeight() const { return height; }
+int FD_AtlasPacker::getUsedWidth() const { return used_width; }
+int FD_AtlasPacker::getUsedHeight() const { return used_height; }
+double FD_AtlasPacker::getOccupancy() const {
+	if (used_width == 0 || used_height == 0) return 0;
+	return static_cast<double>(used_area) / (static_cast<double>(used_width) * used_height);
+}
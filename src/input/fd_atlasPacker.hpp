@@ -0,0 +1,111 @@
+#ifndef FD_ATLAS_PACKER_H_
+#define FD_ATLAS_PACKER_H_
+
+#include <vector>
+#include <cstdint>
+
+#include <SDL_rect.h>
+
+/*!
+	@file
+	@brief The file containing the FD_AtlasPacker class, which places rectangles in a texture atlas.
+*/
+
+//! The class that packs rectangles into a fixed area with the skyline bottom-left method.
+/*!
+	The packer keeps the outline of the placed rectangles' tops, the skyline,
+	and places each rectangle where its top would be lowest, breaking ties
+	by the least width of skyline covered. Packing the tallest rectangles
+	first gives the tightest results.
+
+	The packer only deals with rectangles, so can be used offline as well as by
+	FD_ImageManager::loadAtlas.
+*/
+class FD_AtlasPacker {
+private:
+
+	struct Node {
+		int x, y, w;
+	};
+
+	int width, height;
+	std::vector<Node> skyline{};
+	int used_width{ 0 };
+	int used_height{ 0 };
+	Uint64 used_area{ 0 };
+
+	bool fit(size_t index, int w, int h, int& y) const;
+
+public:
+
+	//! The page given to rectangles too large for any page.
+	static const size_t unpacked{ SIZE_MAX };
+
+	//! Packs rectangles across as many pages as they need, in the order given.
+	/*!
+		Each rectangle is placed on the first page with space for it, opening
+		a new page when none has. Rectangles larger than a page are given the
+		page unpacked and, left out.
+
+		\param width  The width of each page.
+		\param height The height of each page.
+		\param sizes  The rectangles to place, of which only the width and height are used.
+		\param pages  The page of each rectangle, written to.
+		\param placed The placement of each rectangle on its page, written to.
+
+		\return The packer of each page.
+	*/
+	static std::vector<FD_AtlasPacker> packPages(int width, int height,
+		const std::vector<SDL_Rect>& sizes, std::vector<size_t>& pages,
+		std::vector<SDL_Rect>& placed);
+
+	//! Constructs a FD_AtlasPacker.
+	/*!
+		\param width  The width of the area to pack into.
+		\param height The height of the area to pack into.
+	*/
+	FD_AtlasPacker(int width, int height);
+	//! Destroys the FD_AtlasPacker.
+	~FD_AtlasPacker();
+
+	//! Places a rectangle.
+	/*!
+		\param w      The width of the rectangle.
+		\param h      The height of the rectangle.
+		\param placed The rectangle to write the placement to.
+
+		\return Whether there was space for the rectangle.
+	*/
+	bool insert(int w, int h, SDL_Rect& placed);
+	//! Removes every placed rectangle.
+	void clear();
+
+	//! Returns the width of the area to pack into.
+	/*!
+		\return The width of the area to pack into.
+	*/
+	int getWidth() const;
+	//! Returns the height of the area to pack into.
+	/*!
+		\return The height of the area to pack into.
+	*/
+	int getHeight() const;
+	//! Returns the width covered by the placed rectangles.
+	/*!
+		\return The width covered by the placed rectangles.
+	*/
+	int getUsedWidth() const;
+	//! Returns the height covered by the placed rectangles.
+	/*!
+		\return The height covered by the placed rectangles.
+	*/
+	int getUsedHeight() const;
+	//! Returns the share of the used area covered by rectangles.
+	/*!
+		\return The share of the used width by the used height covered, from 0 to 1.
+	*/
+	double getOccupancy() const;
+
+};
+
+#endif
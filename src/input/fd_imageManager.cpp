@@ -1,6 +1,11 @@
 #include "fd_imageManager.hpp"
 
+#include <numeric>
+#include <algorithm>
+
+#include "fd_atlasPacker.hpp"
 #include "../main/fd_handling.hpp"
+#include "../main/fd_profiler.hpp"
 
 // Font Member Functions
 
@@ -55,8 +60,9 @@ void FD_Image::query() {
 		Uint32 f = static_cast<Uint32>(SDL_PIXELFORMAT_UNKNOWN);
 		SDL_QueryTexture(texture,
 			&f, nullptr, &w, &h);
-		this->width = static_cast<Uint32>(w);
-		this->height = static_cast<Uint32>(h);
+		this->width = this->texture_width = static_cast<Uint32>(w);
+		this->height = this->texture_height = static_cast<Uint32>(h);
+		this->region = { 0, 0, w, h };
 		this->loaded = true;
 	}
 }
@@ -67,6 +73,25 @@ void FD_Image::render(SDL_Renderer* renderer, Uint8 alpha,
 	SDL_BlendMode blend, const SDL_Rect* clip) {
 	// If there's no texture or it's completely transparent, stop
 	if (!loaded || texture == nullptr || alpha == 0) return;
+	// Draw through a fresh cache, then reset the renderer and the texture
+	SDL_BlendMode old_draw_blend{};
+	SDL_BlendMode old_texture_blend{};
+	SDL_GetRenderDrawBlendMode(renderer, &old_draw_blend);
+	SDL_GetTextureBlendMode(texture, &old_texture_blend);
+	FD_RenderState state{ renderer };
+	render(state, alpha, srcrect, dstrect, angle, center_x, center_y, flip, blend, clip);
+	if (clip != nullptr) SDL_RenderSetClipRect(renderer, nullptr);
+	if (alpha != 255) SDL_SetTextureAlphaMod(texture, 255);
+	SDL_SetRenderDrawBlendMode(renderer, old_draw_blend);
+	SDL_SetTextureBlendMode(texture, old_texture_blend);
+}
+void FD_Image::render(FD_RenderState& state, Uint8 alpha,
+	const SDL_Rect* srcrect, const SDL_Rect* dstrect,
+	double angle, double center_x, double center_y, SDL_RendererFlip flip,
+	SDL_BlendMode blend, const SDL_Rect* clip) {
+	// If there's no texture or it's completely transparent, stop
+	if (!loaded || texture == nullptr || alpha == 0) return;
+	SDL_Renderer* renderer{ state.getRenderer() };
 	// Prepare the destination
 	SDL_Point temp_center;
 	if (dstrect == nullptr) {
@@ -79,60 +104,33 @@ void FD_Image::render(SDL_Renderer* renderer, Uint8 alpha,
 		temp_center.y = static_cast<int>(center_y * dstrect->h);
 	}
 	SDL_Rect temp_dstrect = (dstrect == nullptr) ? SDL_Rect() : SDL_Rect(*dstrect);
+	SDL_Rect source{ getSourceRect(srcrect) };
 	// Extrude if needed
 	if (extrusion > 0) temp_dstrect = FD_Maths::extrude(temp_dstrect, extrusion);
-	// Set the renderer and the texture's blend modes
-	SDL_BlendMode old_draw_blend{};
-	SDL_BlendMode old_texture_blend{};
-	SDL_GetRenderDrawBlendMode(renderer, &old_draw_blend);
-	SDL_GetTextureBlendMode(texture, &old_texture_blend);
-	SDL_SetRenderDrawBlendMode(renderer, blend);
-	SDL_SetTextureBlendMode(texture, blend);
-	// Set the clipping
-	SDL_Rect* old_clip{ nullptr };
-	bool clipping = (clip != nullptr);
-	if (clipping) {
-		SDL_RenderGetClipRect(renderer, old_clip);
-		SDL_RenderSetClipRect(renderer, clip);
-	}
+	const SDL_Rect* fill{ dstrect == nullptr ? nullptr : &temp_dstrect };
+	state.setClipRect(clip);
 	// If the underlay colour is not completely transparent, draw it
 	if (underlay_colour.a != 0) {
 		// Set the alpha in accordance to the overall alpha
 		Uint8 underlay_alpha = static_cast<Uint8>(underlay_colour.a * (alpha / 255.0));
-		SDL_SetRenderDrawColor(renderer, underlay_colour.r, underlay_colour.g,
+		state.setDrawBlendMode(blend);
+		state.setDrawColour(underlay_colour.r, underlay_colour.g,
 			underlay_colour.b, underlay_alpha);
-		// Fill in the appropriate dstrect
-		if (dstrect == nullptr) {
-			SDL_RenderFillRect(renderer, nullptr);
-		} else {
-			SDL_RenderFillRect(renderer, &temp_dstrect);
-		}
+		SDL_RenderFillRect(renderer, fill);
 	}
 	// Draw the texture to the appropriate dstrect
-	SDL_SetTextureAlphaMod(texture, alpha);
-	if (dstrect == nullptr) {
-		SDL_RenderCopyEx(renderer, texture, srcrect, nullptr, angle, &temp_center, flip);
-	} else {
-		SDL_RenderCopyEx(renderer, texture, srcrect, &temp_dstrect, angle, &temp_center, flip);
-	}
-	if (alpha != 255) SDL_SetTextureAlphaMod(texture, 255);
+	state.setTextureBlendMode(texture, blend);
+	state.setTextureAlphaMod(texture, alpha);
+	SDL_RenderCopyEx(renderer, texture, &source, fill, angle, &temp_center, flip);
 	// If the overlay colour is not completely transparent, draw it
 	if (overlay_colour.a != 0) {
 		// Set the alpha in accordance to the overall alpha
 		Uint8 overlay_alpha = static_cast<Uint8>(overlay_colour.a * (alpha / 255.0));
-		SDL_SetRenderDrawColor(renderer, overlay_colour.r, overlay_colour.g,
+		state.setDrawBlendMode(blend);
+		state.setDrawColour(overlay_colour.r, overlay_colour.g,
 			overlay_colour.b, overlay_alpha);
-		// Fill in the appropriate dstrect
-		if (dstrect == nullptr) {
-			SDL_RenderFillRect(renderer, nullptr);
-		} else {
-			SDL_RenderFillRect(renderer, &temp_dstrect);
-		}
+		SDL_RenderFillRect(renderer, fill);
 	}
-	// Reset the renderer and the texture's blend modes
-	if (clipping) SDL_RenderSetClipRect(renderer, old_clip);
-	SDL_SetRenderDrawBlendMode(renderer, old_draw_blend);
-	SDL_SetTextureBlendMode(texture, old_texture_blend);
 }
 
 bool FD_Image::verify(const FD_ImageRegister path) const { return false; }
@@ -164,6 +162,31 @@ bool FD_Image::isLoaded() const { return loaded; }
 Uint32 FD_Image::getWidth() const { return width; }
 Uint32 FD_Image::getHeight() const { return height; }
 SDL_Texture* FD_Image::getTexture() const { return texture; }
+Uint32 FD_Image::getTextureWidth() const { return texture_width; }
+Uint32 FD_Image::getTextureHeight() const { return texture_height; }
+SDL_Rect FD_Image::getSourceRect(const SDL_Rect* srcrect) const {
+	if (srcrect == nullptr) return region;
+	// Keep to the image, so neighbours in an atlas aren't drawn
+	SDL_Rect bounds{ 0, 0, region.w, region.h };
+	SDL_Rect source{ 0, 0, 0, 0 };
+	if (!SDL_IntersectRect(srcrect, &bounds, &source)) return { region.x, region.y, 0, 0 };
+	return { region.x + source.x, region.y + source.y, source.w, source.h };
+}
+int FD_Image::getExtrusion() const { return extrusion; }
+SDL_Colour FD_Image::getOverlayColour() const { return overlay_colour; }
+SDL_Colour FD_Image::getUnderlayColour() const { return underlay_colour; }
+bool FD_Image::isBatchable() const {
+	return underlay_colour.a == 0 && overlay_colour.a == 0;
+}
+
+// Atlas Image Member Functions
+
+FD_AtlasImage::FD_AtlasImage(SDL_Renderer* renderer, SDL_Surface* surface)
+	: FD_Image(IT_ATLAS) {
+	if (surface != nullptr) texture = SDL_CreateTextureFromSurface(renderer, surface);
+	query();
+}
+FD_AtlasImage::~FD_AtlasImage() { }
 
 // File Image Member Functions
 
@@ -179,13 +202,29 @@ FD_FileImage::FD_FileImage(const std::weak_ptr<FD_Registry> registry,
 	}
 	query();
 }
-FD_FileImage::~FD_FileImage() { }
+FD_FileImage::FD_FileImage(const FD_ImageRegister reg,
+	const std::shared_ptr<FD_AtlasImage> atlas, const SDL_Rect region)
+	: FD_Image(IT_FILE), reg{ reg }, atlas{ atlas } {
+	if (atlas == nullptr || !atlas->isLoaded()) return;
+	this->texture = atlas->getTexture();
+	this->texture_width = atlas->getTextureWidth();
+	this->texture_height = atlas->getTextureHeight();
+	this->region = region;
+	this->width = static_cast<Uint32>(region.w);
+	this->height = static_cast<Uint32>(region.h);
+	this->loaded = true;
+}
+FD_FileImage::~FD_FileImage() {
+	// The atlas owns the texture
+	if (atlas != nullptr) texture = nullptr;
+}
 
 bool FD_FileImage::verify(const FD_ImageRegister reg) const {
 	return this->reg == reg;
 }
 
 FD_ImageRegister FD_FileImage::getRegister() const { return reg; }
+std::shared_ptr<FD_AtlasImage> FD_FileImage::getAtlas() const { return atlas; }
 
 // Text Image Member Functions
 
@@ -201,6 +240,7 @@ FD_TextImage::FD_TextImage(SDL_Renderer* renderer,
 FD_TextImage::~FD_TextImage() { }
 
 void FD_TextImage::changeText(SDL_Renderer* renderer, std::string text) {
+	FD_PROFILE_ZONE("FD_TextImage::changeText");
 	this->text = text;
 	if (texture != nullptr) {
 		SDL_DestroyTexture(texture);
@@ -301,6 +341,7 @@ FD_ImageManager::~FD_ImageManager() {
 }
 
 std::weak_ptr<FD_FileImage> FD_ImageManager::loadImage(const FD_ImageRegister reg) {
+	FD_PROFILE_ZONE("FD_ImageManager::loadImage");
 	// Check if the associated image is already in memory
 	for (std::shared_ptr<FD_FileImage> i : file_images) if (i->verify(reg)) return i;
 	// Load the image, returning it if it has been loaded
@@ -313,6 +354,112 @@ std::weak_ptr<FD_FileImage> FD_ImageManager::loadImage(const FD_ImageRegister re
 	FD_Handling::error("An image could not be loaded.", true);
 	return std::weak_ptr<FD_FileImage>();
 }
+std::vector<std::weak_ptr<FD_FileImage>> FD_ImageManager::loadAtlas(
+	const std::vector<FD_ImageRegister> regs, int max_size, int padding, bool extrude) {
+	FD_PROFILE_ZONE("FD_ImageManager::loadAtlas");
+	if (padding < 0) padding = 0;
+	// Keep to the largest texture the renderer supports
+	SDL_RendererInfo info{};
+	if (SDL_GetRendererInfo(renderer, &info) == 0) {
+		if (info.max_texture_width > 0 && info.max_texture_width < max_size) {
+			max_size = info.max_texture_width;
+		}
+		if (info.max_texture_height > 0 && info.max_texture_height < max_size) {
+			max_size = info.max_texture_height;
+		}
+	}
+	// Load the surfaces of the images not yet loaded
+	struct Packed {
+		FD_ImageRegister reg;
+		SDL_Surface* surface;
+		size_t page;
+		SDL_Rect slot;
+	};
+	std::vector<Packed> packed{};
+	std::shared_ptr<FD_Registry> r;
+	FD_Handling::lock(registry, r, true);
+	for (FD_ImageRegister reg : regs) {
+		auto loaded_image = [reg](const std::shared_ptr<FD_FileImage>& i) { return i->verify(reg); };
+		auto listed = [reg](const Packed& p) { return p.reg == reg; };
+		if (std::any_of(file_images.begin(), file_images.end(), loaded_image)) continue;
+		if (std::any_of(packed.begin(), packed.end(), listed)) continue;
+		std::string path;
+		if (!r->get(reg, path)) continue;
+		FD_Paths::ADD_BASE_PATH(path);
+		SDL_Surface* loaded{ IMG_Load(path.c_str()) };
+		if (loaded == nullptr) continue;
+		SDL_Surface* surface{ SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0) };
+		SDL_FreeSurface(loaded);
+		if (surface == nullptr) continue;
+		// Copy the pixels as they are rather than blending them
+		SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+		packed.push_back({ reg, surface, 0, { 0, 0, 0, 0 } });
+	}
+	// Pack the tallest images first, opening a new atlas when the others are full
+	std::vector<size_t> order(packed.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&packed](size_t a, size_t b) {
+		const SDL_Surface* x{ packed[a].surface };
+		const SDL_Surface* y{ packed[b].surface };
+		return x->h != y->h ? x->h > y->h : x->w > y->w;
+	});
+	std::vector<SDL_Rect> sizes{};
+	for (size_t i : order) {
+		const SDL_Surface* surface{ packed[i].surface };
+		sizes.push_back({ 0, 0, surface->w + 2 * padding, surface->h + 2 * padding });
+	}
+	std::vector<size_t> placed_pages{};
+	std::vector<SDL_Rect> slots{};
+	std::vector<FD_AtlasPacker> pages{ FD_AtlasPacker::packPages(max_size, max_size,
+		sizes, placed_pages, slots) };
+	// Images too large for a page are left unpacked, for bulkLoadImage to load alone
+	for (size_t k = 0; k < order.size(); k++) {
+		packed[order[k]].page = placed_pages[k];
+		packed[order[k]].slot = slots[k];
+	}
+	// Draw each atlas, cropped to the area used, and make the views of it
+	for (size_t page = 0; page < pages.size(); page++) {
+		SDL_Surface* sheet{ SDL_CreateRGBSurfaceWithFormat(0, pages[page].getUsedWidth(),
+			pages[page].getUsedHeight(), 32, SDL_PIXELFORMAT_RGBA32) };
+		if (sheet == nullptr) {
+			FD_Handling::errorSDL("An atlas could not be created.");
+			continue;
+		}
+		for (Packed& p : packed) {
+			if (p.page != page) continue;
+			int x{ p.slot.x + padding }, y{ p.slot.y + padding };
+			int w{ p.surface->w }, h{ p.surface->h };
+			auto copy = [&p, sheet](SDL_Rect from, SDL_Rect to) {
+				SDL_BlitScaled(p.surface, &from, sheet, &to);
+			};
+			copy({ 0, 0, w, h }, { x, y, w, h });
+			if (!extrude || padding == 0) continue;
+			// Stretch the edges and corners over the padding
+			copy({ 0, 0, w, 1 }, { x, y - padding, w, padding });
+			copy({ 0, h - 1, w, 1 }, { x, y + h, w, padding });
+			copy({ 0, 0, 1, h }, { x - padding, y, padding, h });
+			copy({ w - 1, 0, 1, h }, { x + w, y, padding, h });
+			copy({ 0, 0, 1, 1 }, { x - padding, y - padding, padding, padding });
+			copy({ w - 1, 0, 1, 1 }, { x + w, y - padding, padding, padding });
+			copy({ 0, h - 1, 1, 1 }, { x - padding, y + h, padding, padding });
+			copy({ w - 1, h - 1, 1, 1 }, { x + w, y + h, padding, padding });
+		}
+		std::shared_ptr<FD_AtlasImage> atlas{ std::make_shared<FD_AtlasImage>(renderer, sheet) };
+		SDL_FreeSurface(sheet);
+		if (!atlas->isLoaded()) {
+			FD_Handling::errorSDL("An atlas could not be loaded.");
+			continue;
+		}
+		for (Packed& p : packed) {
+			if (p.page != page) continue;
+			SDL_Rect region{ p.slot.x + padding, p.slot.y + padding, p.surface->w, p.surface->h };
+			file_images.push_back(std::make_shared<FD_FileImage>(p.reg, atlas, region));
+		}
+	}
+	for (Packed& p : packed) SDL_FreeSurface(p.surface);
+	// Give the images in order, loading those left out alone
+	return bulkLoadImage(regs);
+}
 std::weak_ptr<FD_TextImage> FD_ImageManager::loadImage(const std::shared_ptr<FD_Font> font,
 	const std::string text,
 	const SDL_Colour colour) {
@@ -323,6 +470,7 @@ std::weak_ptr<FD_TextImage> FD_ImageManager::loadImage(const std::shared_ptr<FD_
 	const std::string text,
 	const std::string suffix,
 	const SDL_Colour colour) {
+	FD_PROFILE_ZONE("FD_ImageManager::loadImage");
 	// Check if the associated image is already in memory
 	for (std::shared_ptr<FD_TextImage> i : text_images) if (i->verify(font, prefix, text, suffix, colour)) return i;
 	// Load the image, returning it if it has been loaded
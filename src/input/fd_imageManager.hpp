@@ -12,6 +12,7 @@
 #include "fd_registry.hpp"
 #include "../maths/fd_maths.hpp"
 #include "../display/fd_resizable.hpp"
+#include "../display/fd_renderState.hpp"
 
 /*!
 	@file
@@ -105,7 +106,11 @@ protected:
 		//! Corresponds to FD_PureImage.
 		IT_PURE,
 		//! Corresponds to FD_GeomImage.
-		IT_GEOM
+		IT_GEOM,
+		//! Corresponds to FD_AtlasImage.
+		IT_ATLAS,
+		//! Corresponds to FD_GroupCache.
+		IT_CACHE
 	};
 
 	//! The type of the image.
@@ -125,6 +130,15 @@ protected:
 	Uint32 height{ 0 };
 	//! The texture of the image.
 	SDL_Texture* texture{ nullptr };
+	//! The area of the texture covered by the image.
+	/*!
+		This is the whole texture unless the image is part of an atlas.
+	*/
+	SDL_Rect region{ 0, 0, 0, 0 };
+	//! The width of the texture.
+	Uint32 texture_width{ 0 };
+	//! The height of the texture.
+	Uint32 texture_height{ 0 };
 	//! The underlay colour of the image.
 	/*!
 		This is drawn before the overlay colour and image are drawn.
@@ -169,6 +183,35 @@ public:
 		SDL_RendererFlip flip = SDL_FLIP_NONE,
 		SDL_BlendMode blend = SDL_BLENDMODE_NONE,
 		const SDL_Rect* clip = nullptr);
+	//! Renders the image through a cache of the renderer's state.
+	/*!
+		Unlike the other overload, the state set for the image is left as it is,
+		so consecutive images sharing a texture, blend mode or clip rectangle
+		don't set them again.
+
+		\param state    The cache of the state of the renderer to use.
+		\param alpha    The alpha of the image.
+		\param srcrect  The source rectangle of the image.
+		\param dstrect  The destination rectangle of the image.
+		\param angle    The angle of the image.
+		\param center_x The x center of the image relative to its top left corner, in units of the image's width.
+		\param center_y The y center of the image relative to its top left corner, in units of the image's height.
+		\param flip     The flip flags of the image.
+		\param blend    The blend mode of the image.
+		\param clip     The clip rectangle of the image.
+
+		\sa FD_Window::getRenderState
+	*/
+	virtual void render(FD_RenderState& state,
+		Uint8 alpha = 255,
+		const SDL_Rect* srcrect = nullptr,
+		const SDL_Rect* dstrect = nullptr,
+		double angle = 0.0,
+		double center_x = 0.5,
+		double center_y = 0.5,
+		SDL_RendererFlip flip = SDL_FLIP_NONE,
+		SDL_BlendMode blend = SDL_BLENDMODE_NONE,
+		const SDL_Rect* clip = nullptr);
 
 	//! Checks whether two images are identical using a register.
 	/*!
@@ -213,6 +256,50 @@ public:
 		\return The raw texture.
 	*/
 	SDL_Texture* getTexture() const;
+	//! Returns the width of the raw texture, which may be an atlas larger than the image.
+	/*!
+		\return The width of the raw texture.
+	*/
+	Uint32 getTextureWidth() const;
+	//! Returns the height of the raw texture, which may be an atlas larger than the image.
+	/*!
+		\return The height of the raw texture.
+	*/
+	Uint32 getTextureHeight() const;
+	//! Returns the area of the raw texture that a source rectangle of the image covers.
+	/*!
+		The source rectangle is kept within the image, so other images in an
+		atlas are never drawn.
+
+		\param srcrect The source rectangle relative to the image, or nullptr for the whole image.
+
+		\return The area of the raw texture.
+	*/
+	SDL_Rect getSourceRect(const SDL_Rect* srcrect) const;
+	//! Returns the extrusion of the image.
+	/*!
+		\return The extrusion of the image.
+
+		\sa extrusion
+	*/
+	int getExtrusion() const;
+	//! Returns the overlay colour.
+	/*!
+		\return The overlay colour.
+	*/
+	SDL_Colour getOverlayColour() const;
+	//! Returns the underlay colour.
+	/*!
+		\return The underlay colour.
+	*/
+	SDL_Colour getUnderlayColour() const;
+	//! Returns whether the image can be drawn as part of a FD_SpriteBatch.
+	/*!
+		Images with an underlay or overlay colour are drawn on their own.
+
+		\return Whether the image can be batched.
+	*/
+	virtual bool isBatchable() const;
 
 	//! Sets the extrusion of the image.
 	/*!
@@ -234,11 +321,34 @@ public:
 
 };
 
+//! The FD_AtlasImage class, specialises the image to hold many others packed into one texture.
+/*!
+	\sa FD_ImageManager::loadAtlas
+*/
+class FD_AtlasImage : public FD_Image {
+public:
+
+	//! Constructs a FD_AtlasImage.
+	/*!
+		\param renderer The renderer to use.
+		\param surface  The surface holding the packed images.
+	*/
+	FD_AtlasImage(SDL_Renderer* renderer, SDL_Surface* surface);
+	//! Destroys the FD_AtlasImage.
+	~FD_AtlasImage();
+
+};
+
 //! The FD_FileImage class, specialising the image to work with files.
+/*!
+	A file image either owns its texture or, is a view of an area of an atlas,
+	which it keeps alive. Source rectangles are relative to the image either way.
+*/
 class FD_FileImage : public FD_Image {
 private:
 
 	FD_ImageRegister reg;
+	std::shared_ptr<FD_AtlasImage> atlas{ nullptr };
 
 public:
 
@@ -250,6 +360,14 @@ public:
 	*/
 	FD_FileImage(const std::weak_ptr<FD_Registry> registry,
 		 const FD_ImageRegister reg, SDL_Renderer* renderer);
+	//! Constructs a FD_FileImage as a view of an area of an atlas.
+	/*!
+		\param reg    The register of the path the image was loaded from.
+		\param atlas  The atlas holding the image.
+		\param region The area of the atlas covered by the image.
+	*/
+	FD_FileImage(const FD_ImageRegister reg,
+		const std::shared_ptr<FD_AtlasImage> atlas, const SDL_Rect region);
 	//! Destroys the FD_FileImage.
 	~FD_FileImage();
 
@@ -266,6 +384,11 @@ public:
 		\return The register of this image.
 	*/
 	FD_ImageRegister getRegister() const;
+	//! Returns the atlas holding the image.
+	/*!
+		\return The atlas holding the image, or nullptr if the image has its own texture.
+	*/
+	std::shared_ptr<FD_AtlasImage> getAtlas() const;
 
 };
 
@@ -438,6 +561,27 @@ public:
 		\return The loaded image.
 	*/
 	std::weak_ptr<FD_FileImage> loadImage(const FD_ImageRegister reg);
+	//! Loads file images packed into as few atlases as possible.
+	/*!
+		Images sharing an atlas share a texture, so can be sorted and batched
+		together. Each image is surrounded by padding which, if extruded,
+		repeats its edge pixels, so images drawn slightly larger (see
+		FD_Image::setToExtrude) or filtered only ever sample their own edges.
+		Images that are already loaded are left as they are and, those too
+		large for an atlas are loaded alone.
+
+		\param regs     The registers to use.
+		\param max_size The largest width and height of an atlas, limited to what the renderer supports.
+		\param padding  The space left around each image.
+		\param extrude  Whether the padding repeats the edges of the image.
+
+		\return The loaded images, in the order of the registers.
+
+		\sa FD_AtlasPacker
+	*/
+	std::vector<std::weak_ptr<FD_FileImage>> loadAtlas(
+		const std::vector<FD_ImageRegister> regs,
+		int max_size = 2048, int padding = 2, bool extrude = true);
 	//! Loads a text image using a font, text and, colour.
 	/*!
 		\param font   The font to use.
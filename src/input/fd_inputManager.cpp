@@ -3,6 +3,7 @@
 #include "fd_input.hpp"
 #include "../maths/fd_maths.hpp"
 #include "../main/fd_handling.hpp"
+#include "../main/fd_profiler.hpp"
 
 // Input Functions 
 
@@ -53,6 +54,7 @@ FD_InputManager::~FD_InputManager() {
 }
 
 void FD_InputManager::update() {
+	FD_PROFILE_ZONE("FD_InputManager::update");
 	// Alert the current set of maps to the inputs
 	if (auto set = getInputSet().lock()) {
 		for (std::shared_ptr<FD_Input> i : pressed) set->call(FD_MAP_PRESSED, i);
@@ -0,0 +1,146 @@
+#include "fd_inputRecording.hpp"
+
+#include <fstream>
+
+#include "../main/fd_handling.hpp"
+
+FD_InputRecording::FD_InputRecording(Uint32 seed) : seed{ seed } {}
+FD_InputRecording::~FD_InputRecording() {}
+
+void FD_InputRecording::record(Uint64 tick, const SDL_Event* events, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		if (isRecordable(events[i])) entries.push_back({ tick, events[i] });
+	}
+	if (tick > length) length = tick;
+}
+void FD_InputRecording::recordTime(Uint32 time) {
+	times.push_back(time);
+}
+void FD_InputRecording::setLength(Uint64 length) {
+	this->length = length;
+}
+void FD_InputRecording::clear() {
+	entries.clear();
+	times.clear();
+	length = 0;
+}
+
+size_t FD_InputRecording::getEvents(Uint64 tick, size_t from,
+	std::vector<SDL_Event>& events) const {
+	// Skip events that were given before earlier updates
+	while (from < entries.size() && entries[from].tick < tick) from++;
+	while (from < entries.size() && entries[from].tick == tick) {
+		events.push_back(entries[from].event);
+		from++;
+	}
+	return from;
+}
+bool FD_InputRecording::getTime(Uint64 tick, Uint32& time) const {
+	if (tick >= times.size()) return false;
+	time = times[static_cast<size_t>(tick)];
+	return true;
+}
+
+bool FD_InputRecording::save(const std::string path) const {
+	std::ofstream file{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+	if (!file.is_open()) {
+		FD_Handling::error("The input recording could not be written to: " + path);
+		return false;
+	}
+	// Write the header
+	Uint64 count{ entries.size() };
+	Uint32 event_size{ sizeof(SDL_Event) };
+	file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+	file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	file.write(reinterpret_cast<const char*>(&event_size), sizeof(event_size));
+	file.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+	file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	// Write the events, with the ticks as deltas
+	Uint64 last{ 0 };
+	for (const Entry& e : entries) {
+		Uint32 delta{ static_cast<Uint32>(e.tick - last) };
+		last = e.tick;
+		file.write(reinterpret_cast<const char*>(&delta), sizeof(delta));
+		file.write(reinterpret_cast<const char*>(&e.event), sizeof(SDL_Event));
+	}
+	// Write the engine time of each update
+	Uint64 time_count{ times.size() };
+	file.write(reinterpret_cast<const char*>(&time_count), sizeof(time_count));
+	if (!times.empty()) {
+		file.write(reinterpret_cast<const char*>(times.data()), times.size() * sizeof(Uint32));
+	}
+	return file.good();
+}
+bool FD_InputRecording::load(const std::string path) {
+	std::ifstream file{ path, std::ios::in | std::ios::binary };
+	if (!file.is_open()) {
+		FD_Handling::error("The input recording could not be read from: " + path);
+		return false;
+	}
+	// Read and check the header
+	Uint32 file_magic{ 0 }, file_version{ 0 }, event_size{ 0 }, file_seed{ 0 };
+	Uint64 file_length{ 0 }, count{ 0 };
+	file.read(reinterpret_cast<char*>(&file_magic), sizeof(file_magic));
+	file.read(reinterpret_cast<char*>(&file_version), sizeof(file_version));
+	file.read(reinterpret_cast<char*>(&event_size), sizeof(event_size));
+	file.read(reinterpret_cast<char*>(&file_seed), sizeof(file_seed));
+	file.read(reinterpret_cast<char*>(&file_length), sizeof(file_length));
+	file.read(reinterpret_cast<char*>(&count), sizeof(count));
+	// Recordings from the first version have no times, but are otherwise the same
+	if (!file.good() || file_magic != magic || file_version < 1 || file_version > version
+		|| event_size != sizeof(SDL_Event)) {
+		FD_Handling::error("The input recording is invalid or from another platform: " + path);
+		return false;
+	}
+	// Read the events
+	std::vector<Entry> read{};
+	Uint64 tick{ 0 };
+	for (Uint64 i = 0; i < count; i++) {
+		Uint32 delta{ 0 };
+		Entry e{};
+		file.read(reinterpret_cast<char*>(&delta), sizeof(delta));
+		file.read(reinterpret_cast<char*>(&e.event), sizeof(SDL_Event));
+		if (!file.good()) {
+			FD_Handling::error("The input recording is truncated: " + path);
+			return false;
+		}
+		tick += delta;
+		e.tick = tick;
+		read.push_back(e);
+	}
+	// Read the engine time of each update
+	std::vector<Uint32> read_times{};
+	if (file_version >= 2) {
+		Uint64 time_count{ 0 };
+		file.read(reinterpret_cast<char*>(&time_count), sizeof(time_count));
+		if (file.good() && time_count <= file_length) {
+			read_times.resize(static_cast<size_t>(time_count));
+			file.read(reinterpret_cast<char*>(read_times.data()), read_times.size() * sizeof(Uint32));
+		}
+		if (!file.good() || time_count > file_length) {
+			FD_Handling::error("The input recording is truncated: " + path);
+			return false;
+		}
+	}
+	entries.swap(read);
+	times.swap(read_times);
+	length = file_length;
+	seed = file_seed;
+	return true;
+}
+
+size_t FD_InputRecording::getEventCount() const { return entries.size(); }
+Uint64 FD_InputRecording::getLength() const { return length; }
+Uint32 FD_InputRecording::getSeed() const { return seed; }
+
+bool FD_InputRecording::isRecordable(const SDL_Event& e) {
+	switch (e.type) {
+	case SDL_DROPFILE:
+	case SDL_DROPTEXT:
+	case SDL_SYSWMEVENT:
+		return false;
+	default:
+		return e.type < SDL_USEREVENT;
+	}
+}
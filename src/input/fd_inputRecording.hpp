@@ -0,0 +1,144 @@
+#ifndef FD_INPUT_RECORDING_H_
+#define FD_INPUT_RECORDING_H_
+
+#include <string>
+#include <vector>
+
+#include <SDL_events.h>
+
+/*!
+	@file
+	@brief The file containing the FD_InputRecording class, allowing input to be recorded and replayed.
+*/
+
+//! The class containing a recording of the events given to a FD_Loopable.
+/*!
+	Each event is recorded with the index of the update it was given before,
+	so that FD_Looper::replay can give it back at the same point. The engine
+	time seen by each update is recorded too, as it follows the real time
+	passed. Along with a seed for FD_RandomGenerator, this allows a run to be
+	reproduced exactly.
+
+	Events holding pointers (dropped files and text, window manager and user
+	events) are not recorded. The file format is native to the platform that
+	wrote it.
+
+	\sa FD_Looper::setRecording
+	\sa FD_Looper::replay
+*/
+class FD_InputRecording {
+private:
+
+	struct Entry {
+		Uint64 tick;
+		SDL_Event event;
+	};
+
+	std::vector<Entry> entries{};
+	std::vector<Uint32> times{};
+	Uint64 length{ 0 };
+	Uint32 seed{ 0 };
+
+	static const Uint32 magic{ 0x52494446 };
+	static const Uint32 version{ 2 };
+
+public:
+
+	//! Constructs a FD_InputRecording.
+	/*!
+		\param seed The seed for FD_RandomGenerator used by the recorded run.
+	*/
+	FD_InputRecording(Uint32 seed = 0);
+	//! Destroys the FD_InputRecording.
+	~FD_InputRecording();
+
+	//! Records events given before an update.
+	/*!
+		\param tick   The index of the update the events were given before.
+		\param events The events given.
+		\param count  The number of events.
+	*/
+	void record(Uint64 tick, const SDL_Event* events, size_t count);
+	//! Records the engine time seen by the next update.
+	/*!
+		Times are recorded in order, one for each update from the first.
+
+		\param time The engine time in milliseconds.
+
+		\sa FD_Clock
+	*/
+	void recordTime(Uint32 time);
+	//! Sets the number of updates the recorded run lasted.
+	/*!
+		\param length The number of updates.
+	*/
+	void setLength(Uint64 length);
+	//! Removes all recorded events and times.
+	void clear();
+
+	//! Appends the events given before an update to a list.
+	/*!
+		Events are searched for from the given position, so replaying
+		every update in order only passes over each event once.
+
+		\param tick   The index of the update.
+		\param from   The position to search from, the return value of the last call.
+		\param events The list to append the events to.
+
+		\return The position to search from next.
+	*/
+	size_t getEvents(Uint64 tick, size_t from, std::vector<SDL_Event>& events) const;
+
+	//! Returns the engine time seen by an update.
+	/*!
+		\param tick The index of the update.
+		\param time The engine time in milliseconds, written to if it was recorded.
+
+		\return Whether the time was recorded, which it isn't in recordings from before times were.
+	*/
+	bool getTime(Uint64 tick, Uint32& time) const;
+
+	//! Writes the recording to a file.
+	/*!
+		\param path The path of the file.
+
+		\return Whether the recording could be written.
+	*/
+	bool save(const std::string path) const;
+	//! Reads a recording from a file, replacing this one.
+	/*!
+		\param path The path of the file.
+
+		\return Whether the recording could be read.
+	*/
+	bool load(const std::string path);
+
+	//! Returns the number of recorded events.
+	/*!
+		\return The number of recorded events.
+	*/
+	size_t getEventCount() const;
+	//! Returns the number of updates the recorded run lasted.
+	/*!
+		\return The number of updates.
+	*/
+	Uint64 getLength() const;
+	//! Returns the seed for FD_RandomGenerator used by the recorded run.
+	/*!
+		\return The seed.
+
+		\sa FD_RandomGenerator::setDefaultSeed
+	*/
+	Uint32 getSeed() const;
+
+	//! Returns whether an event can be recorded.
+	/*!
+		\param e The event in question.
+
+		\return Whether the event holds no pointers.
+	*/
+	static bool isRecordable(const SDL_Event& e);
+
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "fd_frameStats.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+namespace {
+
+	// Selects the nearest ranked sample from a copy
+	std::chrono::nanoseconds selectPercentile(std::vector<Uint64> sorted, double percentile) {
+		if (percentile < 0) percentile = 0;
+		if (percentile > 100) percentile = 100;
+		size_t rank{ static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size())) };
+		if (rank > 0) rank--;
+		std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+		return std::chrono::nanoseconds{ sorted.at(rank) };
+	}
+
+}
+
+FD_FrameStats::FD_FrameStats() {}
+FD_FrameStats::~FD_FrameStats() {}
+
+void FD_FrameStats::setSection(int section) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	this->section = section;
+}
+int FD_FrameStats::getSection() const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	return section;
+}
+
+void FD_FrameStats::record(FD_FramePhase phase, std::chrono::nanoseconds duration) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	samples[{ section, phase }].push_back(static_cast<Uint64>(duration.count()));
+}
+
+bool FD_FrameStats::getPercentile(FD_FramePhase phase, int section,
+	double percentile, std::chrono::nanoseconds& duration) const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	auto it{ samples.find({ section, phase }) };
+	if (it == samples.end() || it->second.empty()) return false;
+	duration = selectPercentile(it->second, percentile);
+	return true;
+}
+size_t FD_FrameStats::getSampleCount(FD_FramePhase phase, int section) const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	auto it{ samples.find({ section, phase }) };
+	if (it == samples.end()) return 0;
+	return it->second.size();
+}
+
+std::string FD_FrameStats::report() const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	std::ostringstream out;
+	out << std::left << std::setw(10) << "Section"
+		<< std::setw(10) << "Phase"
+		<< std::right << std::setw(10) << "Samples"
+		<< std::setw(12) << "p50 (us)"
+		<< std::setw(12) << "p95 (us)"
+		<< std::setw(12) << "p99 (us)" << "\n";
+	out << std::fixed << std::setprecision(1);
+	for (auto& s : samples) {
+		if (s.second.empty()) continue;
+		int section{ s.first.first };
+		FD_FramePhase phase{ static_cast<FD_FramePhase>(s.first.second) };
+		std::chrono::nanoseconds p50{ selectPercentile(s.second, 50) };
+		std::chrono::nanoseconds p95{ selectPercentile(s.second, 95) };
+		std::chrono::nanoseconds p99{ selectPercentile(s.second, 99) };
+		out << std::left << std::setw(10) << section
+			<< std::setw(10) << getPhaseName(phase)
+			<< std::right << std::setw(10) << s.second.size()
+			<< std::setw(12) << p50.count() / 1000.0
+			<< std::setw(12) << p95.count() / 1000.0
+			<< std::setw(12) << p99.count() / 1000.0 << "\n";
+	}
+	return out.str();
+}
+void FD_FrameStats::clear() {
+	std::lock_guard<std::mutex> lock{ mutex };
+	samples.clear();
+}
+
+std::string FD_FrameStats::getPhaseName(FD_FramePhase phase) {
+	switch (phase) {
+	case FD_PHASE_EVENTS: return "events";
+	case FD_PHASE_UPDATE: return "update";
+	case FD_PHASE_RENDER: return "render";
+	case FD_PHASE_SUBMIT: return "submit";
+	case FD_PHASE_PRESENT: return "present";
+	case FD_PHASE_FRAME: return "frame";
+	default: return "unknown";
+	}
+}
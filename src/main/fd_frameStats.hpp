@@ -0,0 +1,114 @@
+#ifndef FD_FRAME_STATS_H_
+#define FD_FRAME_STATS_H_
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <SDL_stdinc.h>
+
+/*!
+	@file
+	@brief A file containing the FD_FrameStats class, allowing the phases of the loop to be timed.
+*/
+
+//! The enumeration containing the timed phases of a loop iteration.
+enum FD_FramePhase {
+	//! The polling and pushing of events.
+	FD_PHASE_EVENTS,
+	//! A single update of the FD_Loopable.
+	FD_PHASE_UPDATE,
+	//! The traversal of the current object list, recording its draw commands.
+	FD_PHASE_RENDER,
+	//! The sorting and drawing of the recorded draw commands.
+	FD_PHASE_SUBMIT,
+	//! The presenting of the renderer.
+	FD_PHASE_PRESENT,
+	//! A whole iteration of the loop.
+	FD_PHASE_FRAME,
+
+	//! The number of phases.
+	FD_PHASE_COUNT
+};
+
+//! The class that records the durations of the phases of a loop.
+/*!
+	Samples are recorded against the current section, which FD_Scene sets to
+	the index of the object list being updated and drawn, so that phases can be
+	compared between object lists.
+	The percentiles are calculated from every recorded sample.
+	Samples may be recorded from multiple threads.
+*/
+class FD_FrameStats {
+private:
+
+	int section{ 0 };
+	mutable std::mutex mutex;
+	std::map<std::pair<int, int>, std::vector<Uint64>> samples{};
+
+public:
+
+	//! Constructs a FD_FrameStats.
+	FD_FrameStats();
+	//! Destroys the FD_FrameStats.
+	~FD_FrameStats();
+
+	//! Sets the section that following samples are recorded against.
+	/*!
+		\param section The new section, usually an object list index.
+	*/
+	void setSection(int section);
+	//! Returns the current section.
+	/*!
+		\return The current section.
+	*/
+	int getSection() const;
+
+	//! Records the duration of a phase.
+	/*!
+		\param phase    The phase that was timed.
+		\param duration The duration of the phase.
+	*/
+	void record(FD_FramePhase phase, std::chrono::nanoseconds duration);
+	//! Returns a percentile of the recorded durations of a phase by reference.
+	/*!
+		\param phase      The phase in question.
+		\param section    The section in question.
+		\param percentile The percentile, between 0 and 100.
+		\param duration   The reference to write the duration to.
+
+		\return Whether any samples of the phase have been recorded in the section.
+	*/
+	bool getPercentile(FD_FramePhase phase, int section,
+		double percentile, std::chrono::nanoseconds& duration) const;
+	//! Returns the number of samples recorded for a phase.
+	/*!
+		\param phase   The phase in question.
+		\param section The section in question.
+
+		\return The number of samples recorded.
+	*/
+	size_t getSampleCount(FD_FramePhase phase, int section) const;
+
+	//! Returns a table of the p50, p95 and, p99 durations of each phase and section.
+	/*!
+		\return The table, with durations in microseconds.
+	*/
+	std::string report() const;
+	//! Removes all recorded samples.
+	void clear();
+
+	//! Returns the name of a phase.
+	/*!
+		\param phase The phase in question.
+
+		\return The name of the phase.
+	*/
+	static std::string getPhaseName(FD_FramePhase phase);
+
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "fd_jobSystem.hpp"
+
+namespace {
+
+	// The job system and queue belonging to the current thread, if it is in a pool
+	thread_local const FD_JobSystem* current_system{ nullptr };
+	thread_local size_t current_index{ 0 };
+
+}
+
+// Job Group Member Functions
+
+FD_JobGroup::FD_JobGroup() {}
+FD_JobGroup::~FD_JobGroup() {}
+
+bool FD_JobGroup::isFinished() const {
+	return pending.load(std::memory_order_acquire) == 0;
+}
+
+// Job System Member Functions
+
+FD_JobSystem::FD_JobSystem() : FD_JobSystem(std::thread::hardware_concurrency() > 1
+	? std::thread::hardware_concurrency() - 1 : 0) {}
+FD_JobSystem::FD_JobSystem(size_t thread_count) {
+	// The first queue is shared by threads outside of the pool
+	for (size_t i = 0; i <= thread_count; i++) queues.push_back(std::make_unique<Queue>());
+	for (size_t i = 1; i <= thread_count; i++) threads.emplace_back(&FD_JobSystem::work, this, i);
+}
+FD_JobSystem::~FD_JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock{ sleep_mutex };
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& t : threads) t.join();
+	// Run anything left over on this thread
+	while (runQueued(0));
+}
+
+size_t FD_JobSystem::getQueueIndex() const {
+	return current_system == this ? current_index : 0;
+}
+bool FD_JobSystem::runQueued(size_t index) {
+	Task task{};
+	bool found{ false };
+	// Take the newest of our own jobs
+	{
+		Queue& own{ *queues[index] };
+		std::lock_guard<std::mutex> lock{ own.mutex };
+		if (!own.tasks.empty()) {
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			found = true;
+		}
+	}
+	// Otherwise steal the oldest job of another thread
+	for (size_t i = 1; !found && i < queues.size(); i++) {
+		Queue& other{ *queues[(index + i) % queues.size()] };
+		std::lock_guard<std::mutex> lock{ other.mutex };
+		if (!other.tasks.empty()) {
+			task = std::move(other.tasks.front());
+			other.tasks.pop_front();
+			found = true;
+		}
+	}
+	if (!found) return false;
+	queued--;
+	task.job();
+	task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+	return true;
+}
+void FD_JobSystem::work(size_t index) {
+	current_system = this;
+	current_index = index;
+	while (true) {
+		if (runQueued(index)) continue;
+		std::unique_lock<std::mutex> lock{ sleep_mutex };
+		wake.wait(lock, [this]() { return stopping || queued > 0; });
+		if (stopping && queued == 0) return;
+	}
+}
+
+void FD_JobSystem::run(FD_JobGroup& group, FD_Job job) {
+	group.pending.fetch_add(1, std::memory_order_relaxed);
+	{
+		Queue& own{ *queues[getQueueIndex()] };
+		std::lock_guard<std::mutex> lock{ own.mutex };
+		own.tasks.push_back({ std::move(job), &group });
+	}
+	{
+		// Increment under the lock so that a sleeping thread can't miss it
+		std::lock_guard<std::mutex> lock{ sleep_mutex };
+		queued++;
+	}
+	wake.notify_one();
+}
+void FD_JobSystem::wait(FD_JobGroup& group) {
+	size_t index{ getQueueIndex() };
+	while (!group.isFinished()) {
+		if (!runQueued(index)) std::this_thread::yield();
+	}
+}
+void FD_JobSystem::parallelFor(size_t begin, size_t end, size_t grain,
+	const std::function<void(size_t, size_t)>& f) {
+	if (grain == 0) grain = 1;
+	if (end <= begin) return;
+	// Run small ranges or those without a pool straight away
+	if (end - begin <= grain || threads.empty()) {
+		f(begin, end);
+		return;
+	}
+	// Queue all but the first chunk, which is ran here
+	FD_JobGroup group{};
+	for (size_t b = begin + grain; b < end; b += grain) {
+		size_t e{ end - b > grain ? b + grain : end };
+		run(group, [&f, b, e]() { f(b, e); });
+	}
+	f(begin, begin + grain);
+	wait(group);
+}
+
+size_t FD_JobSystem::getThreadCount() const { return threads.size(); }
@@ -0,0 +1,128 @@
+#ifndef FD_JOB_SYSTEM_H_
+#define FD_JOB_SYSTEM_H_
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+/*!
+	@file
+	@brief A file containing the FD_JobSystem class, allowing work to be spread across threads.
+*/
+
+//! The type of the jobs ran by FD_JobSystem.
+typedef std::function<void()> FD_Job;
+
+//! The class that tracks a set of jobs so that they can be waited on together.
+/*!
+	A group must outlive the jobs ran against it, which is guaranteed by
+	waiting on it with FD_JobSystem::wait before it is destroyed.
+*/
+class FD_JobGroup {
+private:
+
+	friend class FD_JobSystem;
+	std::atomic<size_t> pending{ 0 };
+
+public:
+
+	//! Constructs a FD_JobGroup.
+	FD_JobGroup();
+	//! Destroys the FD_JobGroup.
+	~FD_JobGroup();
+
+	//! Returns whether every job ran against the group has finished.
+	/*!
+		\return Whether every job has finished.
+	*/
+	bool isFinished() const;
+
+};
+
+//! The class that runs jobs on a pool of threads.
+/*!
+	Every thread of the pool has its own queue of jobs. A thread runs the
+	jobs it queued itself newest first and, once it has none, steals the oldest
+	jobs of the other threads. Threads outside of the pool share one queue.
+	Waiting on a group runs queued jobs until the group has finished, so jobs
+	may run and wait on further jobs (fork-join) without tying up the pool.
+
+	\warning Jobs should not throw, an exception leaving a job terminates execution.
+*/
+class FD_JobSystem {
+private:
+
+	struct Task {
+		FD_Job job;
+		FD_JobGroup* group;
+	};
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> queues{};
+	std::vector<std::thread> threads{};
+
+	std::atomic<bool> stopping{ false };
+	std::atomic<size_t> queued{ 0 };
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+
+	size_t getQueueIndex() const;
+	bool runQueued(size_t index);
+	void work(size_t index);
+
+public:
+
+	//! Constructs a FD_JobSystem.
+	/*!
+		The pool has one fewer thread than the hardware supports, as threads
+		waiting on jobs help to run them.
+	*/
+	FD_JobSystem();
+	//! Constructs a FD_JobSystem.
+	/*!
+		\param thread_count The number of threads in the pool, with 0 running every job whilst waiting.
+	*/
+	FD_JobSystem(size_t thread_count);
+	//! Destroys the FD_JobSystem, finishing queued jobs and joining the pool.
+	~FD_JobSystem();
+
+	//! Queues a job, to be ran by any thread.
+	/*!
+		\param group The group the job is tracked by.
+		\param job   The job to run.
+
+		\sa wait
+	*/
+	void run(FD_JobGroup& group, FD_Job job);
+	//! Runs queued jobs until every job of a group has finished.
+	/*!
+		\param group The group to wait on.
+	*/
+	void wait(FD_JobGroup& group);
+	//! Runs a function over a range split into chunks, in parallel, returning once every chunk is done.
+	/*!
+		\param begin The first index of the range.
+		\param end   The index after the last of the range.
+		\param grain The maximum length of a chunk.
+		\param f     The function ran on each chunk, given the first and after last index of the chunk.
+	*/
+	void parallelFor(size_t begin, size_t end, size_t grain,
+		const std::function<void(size_t, size_t)>& f);
+
+	//! Returns the number of threads in the pool.
+	/*!
+		\return The number of threads in the pool.
+	*/
+	size_t getThreadCount() const;
+
+};
+
+#endif
@@ -1,10 +1,24 @@
 #include "fd_looper.hpp"
 
+#include <thread>
+#include <algorithm>
+
+#include "../maths/fd_clock.hpp"
+#include "../maths/fd_tweenPool.hpp"
+
 // Loopable Member Functions
 
 void FD_Loopable::update() {}
-void FD_Loopable::render() {}
+void FD_Loopable::render(double interpolation) {}
 void FD_Loopable::pushEvent(const SDL_Event* e) {}
+void FD_Loopable::pushEvents(const SDL_Event* events, size_t count) {
+	for (size_t i = 0; i < count; i++) pushEvent(&events[i]);
+}
+void FD_Loopable::pushWindowEvent(const SDL_Event* e) {}
+bool FD_Loopable::hasRenderTasks() { return false; }
+void FD_Loopable::runRenderTasks() {}
+void FD_Loopable::publish() {}
+void FD_Loopable::stopPublishing() {}
 void FD_Loopable::forceClose() { closed = true; }
 bool FD_Loopable::hasClosed() { return closed; }
 
@@ -17,13 +31,187 @@ FD_Looper::FD_Looper(std::shared_ptr<FD_Loopable> loopable, Uint32 ups) {
 }
 FD_Looper::~FD_Looper() {}
 
+void FD_Looper::setFrameStats(std::shared_ptr<FD_FrameStats> stats) {
+	this->stats = stats;
+}
+
+void FD_Looper::setFrameCap(Uint32 fps) {
+	this->fps = fps;
+}
+Uint32 FD_Looper::getFrameCap() const { return fps; }
+void FD_Looper::setPacing(FD_LoopPacing pacing) {
+	this->pacing = pacing;
+}
+FD_LoopPacing FD_Looper::getPacing() const { return pacing; }
+void FD_Looper::setSpinThreshold(std::chrono::nanoseconds threshold) {
+	this->spin_threshold = threshold;
+}
+std::chrono::nanoseconds FD_Looper::getOversleep() const {
+	return std::chrono::nanoseconds{ oversleep.load() };
+}
+
+void FD_Looper::setUpdateLimits(Uint32 max_updates, std::chrono::nanoseconds budget, bool drop_lag) {
+	this->max_updates = max_updates;
+	this->update_budget = budget;
+	this->drop_lag = drop_lag;
+}
+Uint64 FD_Looper::getDroppedTicks() const { return dropped_ticks; }
+Uint64 FD_Looper::getLimitedFrames() const { return limited_frames; }
+
+void FD_Looper::setThreadedUpdate(bool threaded) {
+	this->threaded = threaded;
+}
+bool FD_Looper::isThreadedUpdate() const { return threaded; }
+
+void FD_Looper::setRecording(std::shared_ptr<FD_InputRecording> recording) {
+	this->recording = recording;
+}
+
+void FD_Looper::wait(std::chrono::high_resolution_clock::time_point deadline,
+	std::chrono::nanoseconds& sleep_estimate) {
+	FD_PROFILE_ZONE("FD_Looper::wait");
+	using namespace std::chrono_literals;
+	auto now{ std::chrono::high_resolution_clock::now() };
+	if (pacing == FD_PACING_SLEEP) {
+		// Sleep in short steps while another is expected to finish in time
+		while (deadline - now > spin_threshold + sleep_estimate) {
+			std::this_thread::sleep_for(1ms);
+			auto woke{ std::chrono::high_resolution_clock::now() };
+			std::chrono::nanoseconds slept{
+				std::chrono::duration_cast<std::chrono::nanoseconds>(woke - now) };
+			// Adopt longer sleeps immediately and forget them slowly
+			sleep_estimate = std::max(slept, (sleep_estimate * 15 + slept) / 16);
+			now = woke;
+		}
+		if (now > deadline) {
+			oversleep += std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count();
+		}
+	}
+	// Spin for the remainder
+	while (now < deadline) now = std::chrono::high_resolution_clock::now();
+}
+
+void FD_Looper::pollEvents() {
+	FD_PROFILE_ZONE("FD_Looper::events");
+	// Drain the pending events in bulk
+	SDL_PumpEvents();
+	event_buffer.resize(event_batch);
+	size_t count{ 0 };
+	while (true) {
+		int peeked{ SDL_PeepEvents(event_buffer.data() + count, static_cast<int>(event_batch),
+			SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) };
+		if (peeked <= 0) break;
+		count += static_cast<size_t>(peeked);
+		// Make room for another batch if this one was filled
+		if (static_cast<size_t>(peeked) < event_batch) break;
+		event_buffer.resize(count + event_batch);
+	}
+	if (count == 0) return;
+	if (threaded) {
+		{
+			// Handle window events here, as they may need the renderer, once updating stops
+			std::lock_guard<std::mutex> lock{ update_mutex };
+			pushWindowEvents(event_buffer.data(), count);
+		}
+		// Leave the events for the update thread
+		std::lock_guard<std::mutex> lock{ event_mutex };
+		event_queue.insert(event_queue.end(), event_buffer.begin(), event_buffer.begin() + count);
+		return;
+	}
+	pushWindowEvents(event_buffer.data(), count);
+	dispatchEvents(event_buffer.data(), count);
+}
+void FD_Looper::pushEvents() {
+	{
+		std::lock_guard<std::mutex> lock{ event_mutex };
+		event_queue.swap(event_backlog);
+	}
+	if (!event_backlog.empty()) dispatchEvents(event_backlog.data(), event_backlog.size());
+	event_backlog.clear();
+}
+void FD_Looper::pushWindowEvents(const SDL_Event* events, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		if (events[i].type == SDL_WINDOWEVENT) loopable->pushWindowEvent(&events[i]);
+	}
+}
+void FD_Looper::dispatchEvents(SDL_Event* events, size_t count) {
+	// Close on quitting, passing every other event on as one batch
+	size_t kept{ 0 };
+	for (size_t i = 0; i < count; i++) {
+		if (events[i].type == SDL_QUIT) {
+			loopable->forceClose();
+		} else {
+			if (kept != i) events[kept] = events[i];
+			kept++;
+		}
+	}
+	if (kept == 0) return;
+	if (recording != nullptr) recording->record(tick_index, events, kept);
+	loopable->pushEvents(events, kept);
+}
+
+Uint32 FD_Looper::runUpdates(std::chrono::high_resolution_clock::time_point now,
+	std::chrono::nanoseconds& lag, const std::chrono::nanoseconds timestep) {
+	using namespace std::chrono_literals;
+	Uint32 updates{ 0 };
+	while (lag >= timestep) {
+		// Stop catching up once a limit is reached
+		if ((max_updates > 0 && updates >= max_updates) || (update_budget > 0ns
+			&& std::chrono::high_resolution_clock::now() - now >= update_budget)) {
+			limited_frames++;
+			if (drop_lag) {
+				auto dropped{ lag / timestep };
+				dropped_ticks += static_cast<Uint64>(dropped);
+				lag -= dropped * timestep;
+			}
+			break;
+		}
+		updates++;
+		// Update
+		FD_PROFILE_ZONE("FD_Looper::update");
+		ticks++;
+		tick_index++;
+		auto phase_start{ std::chrono::high_resolution_clock::now() };
+		FD_Clock::advance();
+		// Keep the time this update saw, as it depends on how long frames took
+		if (recording != nullptr) recording->recordTime(FD_Clock::getTicks());
+		FD_TweenPool::get().evaluate();
+		loopable->update();
+		if (stats != nullptr) {
+			stats->record(FD_PHASE_UPDATE, std::chrono::high_resolution_clock::now() - phase_start);
+		}
+		lag -= timestep;
+	}
+	return updates;
+}
+
+void FD_Looper::updateLoop(const std::chrono::nanoseconds timestep) {
+	using namespace std::chrono_literals;
+	std::chrono::nanoseconds lag{ 0ns }, sleep_estimate{ 0ns };
+	auto now{ std::chrono::high_resolution_clock::now() };
+	auto last{ std::chrono::high_resolution_clock::now() };
+	while (!loopable->hasClosed()) {
+		{
+			std::lock_guard<std::mutex> lock{ update_mutex };
+			pushEvents();
+			// Update where needed, publishing the result
+			now = std::chrono::high_resolution_clock::now();
+			lag += now - last;
+			last = now;
+			if (runUpdates(now, lag, timestep) > 0) loopable->publish();
+		}
+		// Wait for the next update
+		wait(now + (timestep - lag), sleep_estimate);
+	}
+	running = false;
+}
+
 void FD_Looper::loop() {
 	// Run the loop
 	FD_Handling::debug("Running the game loop...\n");
-	SDL_Event e;
 	// Prepare chrono variables
 	using namespace std::chrono_literals;
-	std::chrono::nanoseconds lag{ 0ns }, delta{ 0ns };
+	std::chrono::nanoseconds lag{ 0ns };
 	auto now{ std::chrono::high_resolution_clock::now() };
 	auto last{ std::chrono::high_resolution_clock::now() };
 	const std::chrono::nanoseconds second{ static_cast<Uint32>(pow(10, 9)) };
@@ -32,41 +220,144 @@ void FD_Looper::loop() {
 	// Initialise debug tracking variables
 	auto last_debug{ std::chrono::high_resolution_clock::now() };
 	int frames{ 0 };
-	int ticks{ 0 };
-	while (!loopable->hasClosed()) {
+	ticks = 0;
+	// Initialise phase timing variables
+	auto frame_start{ std::chrono::high_resolution_clock::now() };
+	// Initialise pacing variables
+	auto next_frame{ std::chrono::high_resolution_clock::now() };
+	std::chrono::nanoseconds sleep_estimate{ 0ns };
+	long long last_oversleep{ 0 };
+	oversleep = 0;
+	// Initialise update limiting variables
+	Uint64 last_dropped{ 0 };
+	dropped_ticks = limited_frames = 0;
+	tick_index = 0;
+	// Start updating on a separate thread if needed
+	running = true;
+	std::thread worker{ };
+	if (threaded) {
+		// Publish before drawing so that the objects are never read by both threads
+		loopable->publish();
+		worker = std::thread{ &FD_Looper::updateLoop, this, timestep };
+	}
+	while (threaded ? running.load() : !loopable->hasClosed()) {
+		FD_PROFILE_ZONE("FD_Looper::loop");
+		frame_start = std::chrono::high_resolution_clock::now();
 		// Poll events
-		while (SDL_PollEvent(&e)) {
-			switch (e.type) {
-			case SDL_QUIT:
-				loopable->forceClose();
-				continue;
-			default:
-				loopable->pushEvent(&e);
-				continue;
-			}
+		pollEvents();
+		if (!threaded) {
+			loopable->runRenderTasks();
+		} else if (loopable->hasRenderTasks()) {
+			// Tasks queued by updates may change objects, so wait for updating to stop
+			std::lock_guard<std::mutex> lock{ update_mutex };
+			loopable->runRenderTasks();
+		}
+		if (stats != nullptr) {
+			stats->record(FD_PHASE_EVENTS, std::chrono::high_resolution_clock::now() - frame_start);
 		}
 		// Update where needed
 		now = std::chrono::high_resolution_clock::now();
-		delta = now - last;
-		last = now;
-		lag += delta;
-		while (lag >= timestep) {
-			// Update
-			ticks++;
-			loopable->update();
-			lag -= timestep;
-		}
-		// Draw when possible
+		if (!threaded) {
+			lag += now - last;
+			last = now;
+			runUpdates(now, lag, timestep);
+		}
+		// Draw when possible, at one time for the whole frame
 		frames++;
-		loopable->render();
+		if (!threaded) {
+			FD_Clock::advance();
+			FD_TweenPool::get().evaluate();
+		}
+		loopable->render(threaded ? 1.0 : static_cast<double>(lag.count()) / timestep.count());
+		if (stats != nullptr) {
+			stats->record(FD_PHASE_FRAME, std::chrono::high_resolution_clock::now() - frame_start);
+		}
 		// Print debug
 		while (now - last_debug >= second) {
 			last_debug += second;
 			std::string debug{ 
 				"Frames: " + std::to_string(frames) +
-				"  | Updates: " + std::to_string(ticks) };
+				"  | Updates: " + std::to_string(ticks.exchange(0)) +
+				"  | Dropped: " + std::to_string(dropped_ticks - last_dropped) +
+				"  | Oversleep: " + std::to_string((oversleep - last_oversleep) / 1000) + "us" };
 			FD_Handling::debug(debug.c_str());
-			frames = ticks = 0;
+			frames = 0;
+			last_dropped = dropped_ticks;
+			last_oversleep = oversleep;
+		}
+		// Wait for the next frame or, when sleeping uncapped, the next update
+		if (fps > 0) {
+			next_frame += std::chrono::nanoseconds{ static_cast<Uint32>(pow(10, 9) /
+				static_cast<double>(fps)) };
+			// Don't rush to make up for frames that have already been missed
+			auto current{ std::chrono::high_resolution_clock::now() };
+			if (next_frame < current) next_frame = current;
+			wait(next_frame, sleep_estimate);
+		} else if (pacing == FD_PACING_SLEEP) {
+			wait(threaded ? frame_start + timestep : now + (timestep - lag), sleep_estimate);
+		}
+	}
+	if (worker.joinable()) worker.join();
+	running = false;
+	loopable->runRenderTasks();
+	// Later loops may not publish, so shouldn't draw what was published last
+	if (threaded) loopable->stopPublishing();
+	if (recording != nullptr) recording->setLength(tick_index);
+}
+void FD_Looper::replay(std::shared_ptr<FD_InputRecording> recording, bool rendering) {
+	if (recording == nullptr) {
+		FD_Handling::error("The given recording was nullptr.");
+		return;
+	}
+	FD_Handling::debug("Replaying the game loop...\n");
+	// Don't record the replay into another recording
+	std::shared_ptr<FD_InputRecording> previous{ this->recording };
+	this->recording = nullptr;
+	// Only move the clock to the times the recorded updates saw
+	FD_ClockMode previous_mode{ FD_Clock::getMode() };
+	FD_Clock::setMode(FD_CLOCK_STEPPED);
+	const double timestep{ 1000.0 / static_cast<double>(ups) };
+	std::vector<SDL_Event> events{};
+	size_t position{ 0 };
+	tick_index = 0;
+	while (!loopable->hasClosed() && tick_index < recording->getLength()) {
+		FD_PROFILE_ZONE("FD_Looper::replay");
+		auto frame_start{ std::chrono::high_resolution_clock::now() };
+		// Give the events recorded before this update
+		events.clear();
+		position = recording->getEvents(tick_index, position, events);
+		if (!events.empty()) {
+			pushWindowEvents(events.data(), events.size());
+			dispatchEvents(events.data(), events.size());
+		}
+		if (stats != nullptr) {
+			stats->record(FD_PHASE_EVENTS, std::chrono::high_resolution_clock::now() - frame_start);
+		}
+		// Update
+		auto phase_start{ std::chrono::high_resolution_clock::now() };
+		Uint32 time{ 0 };
+		if (recording->getTime(tick_index, time)) {
+			FD_Clock::set(time);
+		} else {
+			FD_Clock::step(timestep);
+		}
+		FD_TweenPool::get().evaluate();
+		loopable->update();
+		tick_index++;
+		if (stats != nullptr) {
+			stats->record(FD_PHASE_UPDATE, std::chrono::high_resolution_clock::now() - phase_start);
+		}
+		loopable->runRenderTasks();
+		// Draw the result, if needed
+		if (rendering) {
+			loopable->publish();
+			loopable->render(1.0);
+			if (stats != nullptr) {
+				stats->record(FD_PHASE_FRAME, std::chrono::high_resolution_clock::now() - frame_start);
+			}
 		}
 	}
+	this->recording = previous;
+	FD_Clock::setMode(previous_mode);
+	if (rendering) loopable->stopPublishing();
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
 #ifndef FD_LOOPER_
 #define FD_LOOPER_
 
+#include <mutex>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "SDL_stdinc.h"
 #include "SDL_events.h"
 
 #include "fd_handling.hpp"
+#include "fd_profiler.hpp"
+#include "fd_frameStats.hpp"
+#include "../input/fd_inputRecording.hpp"
 
 /*!
 	@file
@@ -20,7 +26,7 @@
 /*!
 	This class should be inherited by other classes to allow them to be used within the FD_Looper class.
 	FD_Looper calls update at a fixed, given rate, render as much as possible and, pushEvent as events
-	occur.
+	occur. Render is given how far the loop is between updates so that motion can be interpolated.
 	This class is of little use otherwise.
 */
 class FD_Loopable {
@@ -39,9 +45,55 @@ public:
 	//! The update method to be ran by FD_Looper.
 	virtual void update();
 	//! The render method to be ran by FD_Looper.
-	virtual void render();
+	/*!
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
+	*/
+	virtual void render(double interpolation);
 	//! The event handling method to be ran by FD_Looper.
 	virtual void pushEvent(const SDL_Event* e);
+	//! The batched event handling method ran by FD_Looper, passing each event to pushEvent by default.
+	/*!
+		\param events The events, in the order they occurred.
+		\param count  The number of events.
+	*/
+	virtual void pushEvents(const SDL_Event* events, size_t count);
+	//! The window event handling method ran by FD_Looper on the thread that renders.
+	/*!
+		Window events are given here as they are polled, before they are given
+		to pushEvents with the other events, so that anything made by the
+		renderer can be remade on the thread that owns it. When updating on a
+		separate thread, no update runs at the same time.
+
+		\param e The window event.
+	*/
+	virtual void pushWindowEvent(const SDL_Event* e);
+	//! Returns whether there is work queued for the thread that renders, which may be called from any thread.
+	/*!
+		\return Whether runRenderTasks has anything to run.
+	*/
+	virtual bool hasRenderTasks();
+	//! The method ran by FD_Looper on the thread that renders before each frame, running work queued for it.
+	/*!
+		When updating on a separate thread, this is only ran when
+		hasRenderTasks returns true and, no update runs at the same time.
+	*/
+	virtual void runRenderTasks();
+	//! The method that makes the state of the last update available to render.
+	/*!
+		This is ran by FD_Looper after updating when updates are ran on a separate
+		thread, render should then only draw what was last published.
+
+		\sa FD_Looper::setThreadedUpdate
+	*/
+	virtual void publish();
+	//! The method that has render draw the current state again, rather than the last published.
+	/*!
+		This is ran by FD_Looper on the thread that renders when a loop or,
+		replay that published ends.
+
+		\sa publish
+	*/
+	virtual void stopPublishing();
 	//! The method allowing the FD_Loopable to be closed by force.
 	virtual void forceClose();
 	//! The getter function for closed.
@@ -49,9 +101,22 @@ public:
 
 };
 
+//! The enumeration containing the ways FD_Looper can wait between frames.
+enum FD_LoopPacing {
+	//! Renders again immediately, spinning to meet the frame cap if there is one.
+	FD_PACING_BUSY,
+	//! Sleeps until the next frame deadline (or update if uncapped), spinning for the remainder.
+	FD_PACING_SLEEP
+};
+
 //! The class that runs the methods of FD_Loopable with respect to the rate(s) given.
 /*!
 	This class takes a FD_Loopable and a fixed update rate in hertz (per second).
+	The frame rate can be capped and, the time between frames slept through
+	rather than spent rendering. The engine clock is advanced before each
+	update and, unless updating on a separate thread, before each frame.
+
+	\sa FD_Clock
 */
 class FD_Looper {
 private:
@@ -60,6 +125,91 @@ private:
 	Uint32 ups;
 	//! The FD_Loopable being controller by FD_Looper.
 	std::shared_ptr<FD_Loopable> loopable;
+	//! The statistics the phases of the loop are recorded to, if any.
+	std::shared_ptr<FD_FrameStats> stats{ nullptr };
+
+	//! The maximum rate at which FD_Looper renders, or 0 for no limit.
+	Uint32 fps{ 0 };
+	//! How FD_Looper waits between frames.
+	FD_LoopPacing pacing{ FD_PACING_BUSY };
+	//! The time before a deadline that sleeping stops and spinning begins.
+	std::chrono::nanoseconds spin_threshold{ 2000000 };
+	//! The total time slept beyond a deadline in nanoseconds.
+	std::atomic<long long> oversleep{ 0 };
+
+	//! The maximum number of updates ran before each frame, or 0 for no limit.
+	Uint32 max_updates{ 0 };
+	//! The maximum time spent updating before each frame, or 0 for no limit.
+	std::chrono::nanoseconds update_budget{ 0 };
+	//! Whether the lag left over when a limit is reached is dropped.
+	bool drop_lag{ false };
+	//! The total number of updates dropped.
+	std::atomic<Uint64> dropped_ticks{ 0 };
+	//! The total number of frames that reached an update limit.
+	std::atomic<Uint64> limited_frames{ 0 };
+	//! The number of updates since the last debug message.
+	std::atomic<int> ticks{ 0 };
+
+	//! Whether updates are ran on a separate thread.
+	bool threaded{ false };
+	//! Whether the update thread is still running.
+	std::atomic<bool> running{ false };
+	//! The mutex guarding the event queue.
+	std::mutex event_mutex;
+	//! The events polled but not yet given to the FD_Loopable by the update thread.
+	std::vector<SDL_Event> event_queue{};
+	//! The events being given to the FD_Loopable by the update thread.
+	std::vector<SDL_Event> event_backlog{};
+	//! The buffer events are drained into, reused every frame.
+	std::vector<SDL_Event> event_buffer{};
+	//! The mutex held by the update thread whilst updating, so window events are never handled at the same time.
+	std::mutex update_mutex;
+	//! The number of events drained from SDL at a time.
+	static const size_t event_batch{ 64 };
+
+	//! The recording events are written to, if any.
+	std::shared_ptr<FD_InputRecording> recording{ nullptr };
+	//! The number of updates ran since the loop began.
+	Uint64 tick_index{ 0 };
+
+	//! Waits until the given deadline as per the pacing mode.
+	/*!
+		\param deadline       The time to wait until.
+		\param sleep_estimate The estimated duration of a single short sleep, adjusted as sleeps are observed.
+	*/
+	void wait(std::chrono::high_resolution_clock::time_point deadline,
+		std::chrono::nanoseconds& sleep_estimate);
+	//! Polls the pending events, giving them to the FD_Loopable or queueing them for the update thread.
+	void pollEvents();
+	//! Gives the queued events to the FD_Loopable.
+	void pushEvents();
+	//! Gives the window events of a batch to the FD_Loopable on this thread.
+	/*!
+		\param events The events.
+		\param count  The number of events.
+	*/
+	void pushWindowEvents(const SDL_Event* events, size_t count);
+	//! Gives a batch of events to the FD_Loopable, closing it if one is a quit event.
+	/*!
+		\param events The events to give, which may be overwritten.
+		\param count  The number of events.
+	*/
+	void dispatchEvents(SDL_Event* events, size_t count);
+	//! Runs the updates owed by the lag, within the update limits.
+	/*!
+		\param now      When the lag was last accumulated.
+		\param lag      The lag, reduced by the updates ran.
+		\param timestep The time between updates.
+
+		\return The number of updates ran.
+	*/
+	Uint32 runUpdates(std::chrono::high_resolution_clock::time_point now,
+		std::chrono::nanoseconds& lag, const std::chrono::nanoseconds timestep);
+	//! Updates the FD_Loopable until it closes, ran on the update thread.
+	/*!
+		\param timestep The time between updates.
+	*/
+	void updateLoop(const std::chrono::nanoseconds timestep);
 
 public:
 
@@ -76,6 +226,114 @@ public:
 	//! Destroys the FD_Looper.
 	~FD_Looper();
 
+	//! Sets the statistics that the durations of the events, update and, frame phases are recorded to.
+	/*!
+		\param stats The statistics to record to, or nullptr to stop recording.
+
+		\sa FD_FrameStats
+	*/
+	void setFrameStats(std::shared_ptr<FD_FrameStats> stats);
+
+	//! Sets the maximum rate at which the FD_Loopable is rendered.
+	/*!
+		\param fps The frame rate in hertz (per second), or 0 for no limit.
+	*/
+	void setFrameCap(Uint32 fps);
+	//! Returns the maximum rate at which the FD_Loopable is rendered.
+	/*!
+		\return The frame rate in hertz (per second), or 0 if there is no limit.
+	*/
+	Uint32 getFrameCap() const;
+	//! Sets how the FD_Looper waits between frames.
+	/*!
+		With FD_PACING_SLEEP and no frame cap, the FD_Looper renders once
+		per update and sleeps in between.
+
+		\param pacing The pacing mode.
+
+		\sa FD_LoopPacing
+	*/
+	void setPacing(FD_LoopPacing pacing);
+	//! Returns how the FD_Looper waits between frames.
+	/*!
+		\return The pacing mode.
+	*/
+	FD_LoopPacing getPacing() const;
+	//! Sets how long before a deadline the FD_Looper stops sleeping and spins instead.
+	/*!
+		Larger thresholds trade CPU time for precision on systems with coarse sleep timers.
+
+		\param threshold The spin threshold.
+	*/
+	void setSpinThreshold(std::chrono::nanoseconds threshold);
+	//! Returns the total time slept beyond a deadline since the loop began.
+	/*!
+		\return The total oversleep.
+	*/
+	std::chrono::nanoseconds getOversleep() const;
+
+	//! Sets the limits on how many updates are ran to catch up before each frame.
+	/*!
+		When an update stalls, the FD_Looper would otherwise run every update it
+		fell behind by before rendering again, which can stall it further.
+		Once a limit is reached the remaining lag is either carried over to
+		following frames or, if dropped, discarded so that the FD_Loopable
+		runs slower rather than freezing.
+
+		\param max_updates The maximum number of updates per frame, or 0 for no limit.
+		\param budget      The maximum time spent updating per frame, or 0 for no limit.
+		\param drop_lag    Whether lag left over by a limit is discarded.
+	*/
+	void setUpdateLimits(Uint32 max_updates, std::chrono::nanoseconds budget, bool drop_lag);
+	//! Returns the total number of updates dropped since the loop began.
+	/*!
+		\return The number of dropped updates.
+
+		\sa setUpdateLimits
+	*/
+	Uint64 getDroppedTicks() const;
+	//! Returns the total number of frames that reached an update limit since the loop began.
+	/*!
+		\return The number of limited frames.
+
+		\sa setUpdateLimits
+	*/
+	Uint64 getLimitedFrames() const;
+
+	//! Sets whether the FD_Loopable is updated on a separate thread.
+	/*!
+		The update thread runs update, pushEvent and, publish, whilst this
+		thread polls events and runs render, pushWindowEvent and,
+		runRenderTasks, so heavy updates overlap with drawing. Render is given an interpolation of 1 as it draws the last
+		published state.
+
+		\param threaded Whether to update on a separate thread.
+
+		\warning Updates should then avoid SDL calls that must be made on the
+		main thread, such as creating textures or changing the window, or pass
+		them to FD_Window::runOnRenderThread.
+
+		\sa FD_Loopable::publish
+	*/
+	void setThreadedUpdate(bool threaded);
+	//! Returns whether the FD_Loopable is updated on a separate thread.
+	/*!
+		\return Whether the FD_Loopable is updated on a separate thread.
+	*/
+	bool isThreadedUpdate() const;
+
+	//! Sets the recording that the events given to the FD_Loopable are written to.
+	/*!
+		Events are recorded with the index of the update they were given
+		before, the engine time each update sees is recorded and, the length
+		of the recording is set when the loop ends.
+
+		\param recording The recording to write to, or nullptr to stop recording.
+
+		\sa replay
+	*/
+	void setRecording(std::shared_ptr<FD_InputRecording> recording);
+
 	//! Initialises the loop, updating, rendering and, pushing events to the given FD_Loopable.
 	/*!
 		This loop can be terminated by the FD_Loopable closing itself.
@@ -83,6 +341,24 @@ public:
 		\sa FD_Loopable
 	*/
 	void loop();
+	//! Runs the loop from a recording instead of SDL, as fast as possible.
+	/*!
+		Before each update, the events recorded before the same update are given
+		to the FD_Loopable. The replay ends when the FD_Loopable closes or, the
+		recording runs out. For the run to be reproduced, the FD_Loopable should
+		be constructed after seeding FD_RandomGenerator with the recording's seed.
+		Before each update, the engine clock is set to the time the same update
+		saw when recorded, so tweens, timers and, noise read the same times.
+		Recordings without times step the clock by one update instead, which
+		only matches runs that kept up with their update rate. Frames drawn
+		during the replay see the time of the last update.
+
+		\param recording The recording to replay.
+		\param rendering Whether to render after each update.
+
+		\sa FD_RandomGenerator::setDefaultSeed
+	*/
+	void replay(std::shared_ptr<FD_InputRecording> recording, bool rendering = true);
 
 };
 
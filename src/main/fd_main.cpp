@@ -19,14 +19,21 @@
 
 #include "fd_handling.hpp"
 #include "test/fd_testing.hpp"
+#include "test/fd_benchmark.hpp"
+#include "fd_profiler.hpp"
 
-bool FD_Main::initialise() {
+bool FD_Main::initialise(bool headless) {
 	// Hide the console
 #ifdef FD_DEBUG
 	ShowWindow(GetConsoleWindow(), SW_SHOW);
 #else
-	ShowWindow(GetConsoleWindow(), SW_HIDE);
+	ShowWindow(GetConsoleWindow(), headless ? SW_SHOW : SW_HIDE);
 #endif
+	// Use the dummy drivers when there is no display
+	if (headless) {
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+	}
 	// Start initialisation
 	FD_Handling::debug("Fluxdrive - initialising...");
 	// Initialise SDL
@@ -66,6 +73,35 @@ void FD_Main::test() {
 	FD_Handling::debug("\nAll tests pass, resuming normal execution...\n");
 }
 
+void FD_Main::benchmark(unsigned int ticks, unsigned int ups, bool threaded) {
+	FD_Handling::debug("Fluxdrive Benchmark - initialising...\n");
+	std::cout << (threaded ? "Threaded update:" : "Single threaded update:") << "\n"
+		<< FD_Benchmark::run(ticks, ups, threaded) << std::endl;
+#ifdef FD_PROFILE
+	if (FD_Profiler::dump("fd_benchmark_trace.json")) {
+		FD_Handling::debug("Trace written to fd_benchmark_trace.json.");
+	} else FD_Handling::error("The trace could not be written.");
+#endif
+	FD_Handling::debug("\nBenchmark complete, resuming normal execution...\n");
+}
+
+void FD_Main::benchmarkEasing() {
+	FD_Handling::debug("Fluxdrive Easing Benchmark - initialising...\n");
+	std::cout << FD_Benchmark::easing() << std::endl;
+	FD_Handling::debug("\nBenchmark complete, resuming normal execution...\n");
+}
+
+void FD_Main::benchmarkChurn() {
+	FD_Handling::debug("Fluxdrive Churn Benchmark - initialising...\n");
+	std::cout << FD_Benchmark::churn() << std::endl;
+	FD_Handling::debug("\nBenchmark complete, resuming normal execution...\n");
+}
+void FD_Main::benchmarkAtlas() {
+	FD_Handling::debug("Fluxdrive Atlas Check - initialising...\n");
+	std::cout << FD_Benchmark::atlas() << std::endl;
+	FD_Handling::debug("\nCheck complete, resuming normal execution...\n");
+}
+
 void FD_Main::close() {
 	FD_Handling::debug("Deallocating memory...");
 	SDL_StopTextInput();
@@ -85,3 +121,15 @@ int main() {
 	FD_Main::close();
 }
 #endif
+
+#ifdef FD_BENCHMARK
+int main() {
+	if (!FD_Main::initialise(true)) return EXIT_FAILURE;
+	FD_Main::benchmark();
+	FD_Main::benchmark(1200, 120, true);
+	FD_Main::benchmarkEasing();
+	FD_Main::benchmarkChurn();
+	FD_Main::benchmarkAtlas();
+	FD_Main::close();
+}
+#endif
@@ -12,12 +12,28 @@ namespace FD_Main {
 	/*!
 		This should be called before any Fluxdrive related classes are constructed.
 		If called, close should be called before execution ends.
+
+		\param headless Whether SDL should use its dummy video and audio drivers, for benchmarking.
 		
 		\sa close
 	*/
-	bool initialise();
+	bool initialise(bool headless = false);
 	//! Runs the Fluxdrive test suite.
 	void test();
+	//! Runs the Fluxdrive benchmark, printing the per-phase timings.
+	/*!
+		\param ticks    The total number of updates to run.
+		\param ups      The update rate to run at.
+		\param threaded Whether updates are ran on a separate thread.
+	*/
+	void benchmark(unsigned int ticks = 1200, unsigned int ups = 120,
+		bool threaded = false);
+	//! Runs the Fluxdrive easing microbenchmark, printing the time taken per value.
+	void benchmarkEasing();
+	//! Runs the Fluxdrive object group churn microbenchmark, printing the time taken per update.
+	void benchmarkChurn();
+	//! Runs the Fluxdrive atlas packing check, printing whether it passed.
+	void benchmarkAtlas();
 	//! Closes Fluxdrive and SDL. 
 	/*!
 		If initialise is called, close should also be called before the execution ends.
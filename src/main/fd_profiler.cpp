@@ -0,0 +1,110 @@
+#include "fd_profiler.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+
+	const std::chrono::steady_clock::time_point epoch{ std::chrono::steady_clock::now() };
+	std::atomic<bool> enabled{ true };
+
+	std::mutex registry_mutex;
+	std::vector<std::shared_ptr<FD_Profiler::FD_ProfileBuffer>> registry{};
+
+	// Returns the buffer of the calling thread, registering it on first use
+	FD_Profiler::FD_ProfileBuffer& getBuffer() {
+		thread_local std::shared_ptr<FD_Profiler::FD_ProfileBuffer> buffer{ nullptr };
+		if (buffer == nullptr) {
+			buffer = std::make_shared<FD_Profiler::FD_ProfileBuffer>();
+			buffer->events.resize(FD_Profiler::buffer_capacity);
+			std::lock_guard<std::mutex> lock{ registry_mutex };
+			buffer->thread = static_cast<Uint32>(registry.size());
+			registry.push_back(buffer);
+		}
+		return *buffer;
+	}
+
+	// Writes a string to the stream as a JSON string
+	void writeString(std::ostream& out, const char* s) {
+		out << '"';
+		for (; *s != '\0'; s++) {
+			if (*s == '"' || *s == '\\') out << '\\';
+			out << *s;
+		}
+		out << '"';
+	}
+
+}
+
+Uint64 FD_Profiler::now() {
+	return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - epoch).count());
+}
+
+void FD_Profiler::record(const char* name, Uint64 start, Uint64 duration) {
+	if (!enabled.load(std::memory_order_relaxed)) return;
+	FD_ProfileBuffer& buffer{ getBuffer() };
+	std::lock_guard<std::mutex> lock{ buffer.mutex };
+	buffer.events[buffer.next] = { name, start, duration };
+	if (++buffer.next == buffer.events.size()) {
+		buffer.next = 0;
+		buffer.wrapped = true;
+	}
+}
+
+void FD_Profiler::setEnabled(bool enabled) {
+	::enabled.store(enabled);
+}
+bool FD_Profiler::isEnabled() { return enabled.load(); }
+
+std::string FD_Profiler::toJSON() {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[";
+	bool first{ true };
+	std::lock_guard<std::mutex> registry_lock{ registry_mutex };
+	for (auto& buffer : registry) {
+		std::lock_guard<std::mutex> lock{ buffer->mutex };
+		// Read from the oldest zone if the buffer has wrapped
+		size_t count{ buffer->wrapped ? buffer->events.size() : buffer->next };
+		size_t begin{ buffer->wrapped ? buffer->next : 0 };
+		for (size_t i = 0; i < count; i++) {
+			const FD_ProfileEvent& e{ buffer->events[(begin + i) % buffer->events.size()] };
+			if (!first) out << ",";
+			first = false;
+			out << "\n{\"name\":";
+			writeString(out, e.name);
+			out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread
+				<< ",\"ts\":" << e.start / 1000.0
+				<< ",\"dur\":" << e.duration / 1000.0 << "}";
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return out.str();
+}
+bool FD_Profiler::dump(const std::string path) {
+	std::ofstream file{ path, std::ios::out | std::ios::trunc };
+	if (!file.is_open()) return false;
+	file << toJSON();
+	return file.good();
+}
+void FD_Profiler::clear() {
+	std::lock_guard<std::mutex> registry_lock{ registry_mutex };
+	for (auto& buffer : registry) {
+		std::lock_guard<std::mutex> lock{ buffer->mutex };
+		buffer->next = 0;
+		buffer->wrapped = false;
+	}
+}
+
+// Profile Zone Member Functions
+
+FD_Profiler::FD_ProfileZone::FD_ProfileZone(const char* name)
+	: name{ name }, start{ FD_Profiler::now() } {}
+FD_Profiler::FD_ProfileZone::~FD_ProfileZone() {
+	FD_Profiler::record(name, start, FD_Profiler::now() - start);
+}
@@ -0,0 +1,137 @@
+#ifndef FD_PROFILER_H_
+#define FD_PROFILER_H_
+
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+/*!
+	@file
+	@brief A file containing the FD_Profiler namespace, allowing zones of code to be traced.
+
+	Zones are only recorded when FD_PROFILE is defined using #define, otherwise
+	FD_PROFILE_ZONE expands to nothing and costs nothing.
+*/
+
+//! The namespace containing the trace profiler.
+/*!
+	Each thread writes the zones it completes to its own ring buffer, so
+	threads don't wait on each other to record. Each buffer is guarded by a
+	mutex that is otherwise uncontended, meaning recording only waits whilst
+	toJSON, dump or, clear is reading or emptying that thread's buffer. When
+	a buffer is full the oldest zones are overwritten. The buffers can be
+	written out as Chrome trace-event JSON, viewable in chrome://tracing or
+	Perfetto.
+*/
+namespace FD_Profiler {
+
+	//! A completed zone.
+	struct FD_ProfileEvent {
+		//! The name of the zone, which must outlive the profiler.
+		const char* name;
+		//! When the zone began in nanoseconds since the profiler epoch.
+		Uint64 start;
+		//! The duration of the zone in nanoseconds.
+		Uint64 duration;
+	};
+
+	//! The ring buffer of zones completed by a single thread.
+	struct FD_ProfileBuffer {
+		//! The ID given to the thread owning the buffer.
+		Uint32 thread;
+		//! The recorded zones.
+		std::vector<FD_ProfileEvent> events;
+		//! The index the next zone is written to.
+		size_t next{ 0 };
+		//! Whether the buffer has wrapped around.
+		bool wrapped{ false };
+		//! The mutex guarding the buffer from being read as it's written.
+		std::mutex mutex;
+	};
+
+	//! The number of zones each thread keeps.
+	const size_t buffer_capacity{ 1 << 16 };
+
+	//! Returns the time since the profiler epoch.
+	/*!
+		\return The time in nanoseconds.
+	*/
+	Uint64 now();
+	//! Records a completed zone to the ring buffer of the calling thread.
+	/*!
+		\param name     The name of the zone, which must outlive the profiler.
+		\param start    When the zone began in nanoseconds since the profiler epoch.
+		\param duration The duration of the zone in nanoseconds.
+
+		\warning This blocks whilst the buffer is being read by another thread.
+	*/
+	void record(const char* name, Uint64 start, Uint64 duration);
+
+	//! Sets whether zones are recorded.
+	/*!
+		\param enabled Whether zones should be recorded.
+	*/
+	void setEnabled(bool enabled);
+	//! Returns whether zones are recorded.
+	/*!
+		\return Whether zones are recorded.
+	*/
+	bool isEnabled();
+
+	//! Returns the recorded zones of every thread as Chrome trace-event JSON.
+	/*!
+		Each buffer is locked whilst its zones are written out, stalling its
+		thread if it records a zone meanwhile.
+
+		\return The JSON document.
+	*/
+	std::string toJSON();
+	//! Writes the recorded zones of every thread to a Chrome trace-event JSON file.
+	/*!
+		\param path The path of the file to write.
+
+		\return Whether the file was written.
+	*/
+	bool dump(const std::string path);
+	//! Removes the recorded zones of every thread.
+	void clear();
+
+	//! The class that records a zone over its lifetime.
+	/*!
+		This should be used through FD_PROFILE_ZONE so that it can be removed at compile time.
+	*/
+	class FD_ProfileZone {
+	private:
+
+		const char* name;
+		Uint64 start;
+
+	public:
+
+		//! Constructs a FD_ProfileZone, beginning the zone.
+		/*!
+			\param name The name of the zone, which must outlive the profiler.
+		*/
+		FD_ProfileZone(const char* name);
+		//! Destroys the FD_ProfileZone, recording the zone.
+		~FD_ProfileZone();
+
+	};
+
+}
+
+#define FD_PROFILE_CONCAT_(a, b) a##b
+#define FD_PROFILE_CONCAT(a, b) FD_PROFILE_CONCAT_(a, b)
+
+#ifdef FD_PROFILE
+//! Records the remainder of the enclosing scope as a zone with the given name.
+#define FD_PROFILE_ZONE(name) FD_Profiler::FD_ProfileZone \
+	FD_PROFILE_CONCAT(fd_profile_zone_, __LINE__){ name }
+#else
+#define FD_PROFILE_ZONE(name)
+#endif
+
+#endif
@@ -0,0 +1,346 @@
+#include "fd_benchmark.hpp"
+
+#include <chrono>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "../../maths/fd_easing.hpp"
+#include "../../input/fd_atlasPacker.hpp"
+#include "../../factory/fd_factory.hpp"
+
+namespace {
+
+	// The per-value switch FD_Tween::value used before FD_Easing, kept as a baseline
+	double switchEase(FD_TweenType type, double t) {
+		switch (type) {
+		case FD_TWEEN_LINEAR: return t;
+		case FD_TWEEN_EASE_IN: return pow(t, 3);
+		case FD_TWEEN_EASE_OUT: return 1 - pow(1 - t, 3);
+		case FD_TWEEN_ELASTIC: return pow(2, -10 * t) * sin((t - 0.3 / 4) * (2 * 3.14159) / 0.3) + 1;
+		default: return FD_Easing::ease(type, t);
+		}
+	}
+
+	// Times a method of easing, returning the nanoseconds per value
+	template <typename F>
+	double timeEasing(const std::vector<double>& source, std::vector<double>& work,
+		size_t repeats, F ease) {
+		double checksum{ 0 };
+		auto start{ std::chrono::high_resolution_clock::now() };
+		for (size_t r = 0; r < repeats; r++) {
+			work = source;
+			ease(work.data(), work.size());
+			checksum += work[r % work.size()];
+		}
+		auto taken{ std::chrono::high_resolution_clock::now() - start };
+		// Use the results so that the work isn't optimised away
+		if (checksum == 0.123456789) FD_Handling::debug("Unlikely checksum.");
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(taken).count())
+			/ static_cast<double>(source.size() * repeats);
+	}
+
+	// The single vector sorted by layer FD_ObjectGroup used before its layer buckets, kept as a baseline
+	class SortedGroup {
+	private:
+		std::vector<std::shared_ptr<FD_Layered>> list{};
+	public:
+		void addObject(const std::shared_ptr<FD_Layered>& o) {
+			auto after = std::upper_bound(list.begin(), list.end(), o->getLayer(),
+				[](int layer, const std::shared_ptr<FD_Layered>& other) { return layer < other->getLayer(); });
+			list.insert(after, o);
+		}
+		void updateObjects() {
+			std::vector<std::shared_ptr<FD_Layered>> to_readd{};
+			size_t kept{ 0 };
+			for (size_t i = 0; i < list.size(); i++) {
+				if (list[i].use_count() == 1) continue;
+				if (list[i]->hasChangedLayer()) {
+					to_readd.push_back(list[i]);
+				} else {
+					if (kept != i) list[kept] = std::move(list[i]);
+					kept++;
+				}
+			}
+			list.resize(kept);
+			for (auto& o : to_readd) addObject(o);
+			for (auto& o : list) o->tick();
+		}
+	};
+
+	// Churns a group of boxes, returning the milliseconds per update
+	template <class Group>
+	double timeChurn(Group& group, size_t count, double rate, size_t ticks) {
+		const int layers{ 16 };
+		FD_RandomGenerator random{};
+		random.setSeed(1);
+		SDL_Colour colour{ 255, 255, 255, 255 };
+		auto make = [&]() {
+			return std::make_shared<FD_Box>(random.randomDouble(0, 1920), random.randomDouble(0, 1080),
+				16, 16, random.randomInteger(0, layers), true, colour);
+		};
+		std::vector<std::shared_ptr<FD_Box>> boxes(count);
+		for (auto& b : boxes) {
+			b = make();
+			group.addObject(b);
+		}
+		group.updateObjects();
+		size_t churned{ static_cast<size_t>(count * rate / 2) };
+		std::chrono::nanoseconds taken{ 0 };
+		for (size_t t = 0; t < ticks; t++) {
+			for (size_t i = 0; i < churned; i++) {
+				boxes[random.randomInteger(0, static_cast<int>(count))]->setLayer(random.randomInteger(0, layers));
+			}
+			// Make the replacements beforehand so only the group is timed
+			std::vector<std::shared_ptr<FD_Box>> replacements(churned);
+			for (auto& b : replacements) b = make();
+			auto start{ std::chrono::high_resolution_clock::now() };
+			for (auto& b : replacements) {
+				group.addObject(b);
+				boxes[random.randomInteger(0, static_cast<int>(count))] = std::move(b);
+			}
+			group.updateObjects();
+			taken += std::chrono::high_resolution_clock::now() - start;
+		}
+		return static_cast<double>(taken.count()) / 1e6 / static_cast<double>(ticks);
+	}
+
+}
+
+// Runs the object group churn microbenchmark
+std::string FD_Benchmark::churn(size_t count, double rate, size_t ticks) {
+	double sorted{ 0 }, bucketed{ 0 };
+	{
+		SortedGroup group{};
+		sorted = timeChurn(group, count, rate, ticks);
+	}
+	{
+		FD_ObjectGroup group{ 0 };
+		bucketed = timeChurn(group, count, rate, ticks);
+	}
+	std::ostringstream out{};
+	out << std::fixed << std::setprecision(3);
+	out << count << " objects, " << static_cast<int>(rate * 100) << "% churned per update (ms per update):\n";
+	out << std::left << std::setw(16) << "Sorted vector" << std::right << std::setw(10) << sorted << "\n";
+	out << std::left << std::setw(16) << "Layer buckets" << std::right << std::setw(10) << bucketed << "\n";
+	return out.str();
+}
+
+// Packs rectangles across atlas pages and checks the placements
+std::string FD_Benchmark::atlas(size_t count, int size) {
+	// Seeded so every run packs the same rectangles
+	FD_RandomGenerator random{};
+	random.setSeed(2048);
+	std::vector<SDL_Rect> sizes{};
+	for (size_t i = 0; i < count; i++) {
+		// Every tenth rectangle is too large for a page, one way or the other
+		int large{ i % 10 == 0 ? size + 1 : 0 };
+		int w{ random.randomInteger(1, size / 8) }, h{ random.randomInteger(1, size / 8) };
+		sizes.push_back({ 0, 0, (i % 20 == 0) ? large : w, (i % 20 == 10) ? large : h });
+	}
+	// Tallest first, as FD_ImageManager::loadAtlas orders them
+	std::stable_sort(sizes.begin(), sizes.end(), [](const SDL_Rect& a, const SDL_Rect& b) {
+		return a.h > b.h;
+	});
+	std::vector<size_t> pages{};
+	std::vector<SDL_Rect> placed{};
+	std::vector<FD_AtlasPacker> packers{ FD_AtlasPacker::packPages(size, size, sizes, pages, placed) };
+	size_t failures{ 0 }, oversized{ 0 };
+	for (size_t i = 0; i < sizes.size(); i++) {
+		bool fits{ sizes[i].w <= size && sizes[i].h <= size };
+		if (!fits) oversized++;
+		if (pages[i] == FD_AtlasPacker::unpacked) {
+			if (fits) failures++;
+			continue;
+		}
+		const SDL_Rect& r{ placed[i] };
+		if (!fits || pages[i] >= packers.size() || r.w != sizes[i].w || r.h != sizes[i].h
+			|| r.x < 0 || r.y < 0 || r.x + r.w > size || r.y + r.h > size) {
+			failures++;
+			continue;
+		}
+		for (size_t j = 0; j < i; j++) {
+			if (pages[j] == pages[i] && SDL_HasIntersection(&placed[j], &r)) failures++;
+		}
+	}
+	double occupancy{ 0 };
+	for (const FD_AtlasPacker& packer : packers) occupancy += packer.getOccupancy();
+	if (!packers.empty()) occupancy /= static_cast<double>(packers.size());
+	std::ostringstream out{};
+	out << std::fixed << std::setprecision(1);
+	out << count << " rectangles, " << oversized << " larger than a " << size << "x" << size << " page:\n";
+	out << packers.size() << " pages, " << occupancy * 100 << "% occupied - "
+		<< (failures == 0 ? "passed" : "FAILED") << " (" << failures << " bad placements)\n";
+	return out.str();
+}
+
+// Runs the easing microbenchmark
+std::string FD_Benchmark::easing(size_t count, size_t repeats) {
+	const char* names[FD_Easing::type_count]{ "Linear", "Ease in", "Ease out",
+		"Elastic", "Cubic bezier", "Spring" };
+	FD_RandomGenerator random{};
+	std::vector<double> source(count), work(count);
+	for (double& p : source) p = random.randomDouble(0, 1);
+	std::ostringstream out{};
+	out << std::left << std::setw(14) << "Curve (ns)" << std::right
+		<< std::setw(10) << "Switch" << std::setw(10) << "Policy" << std::setw(10) << "Table" << "\n";
+	out << std::fixed << std::setprecision(2);
+	for (size_t t = 0; t < FD_Easing::type_count; t++) {
+		FD_TweenType type{ static_cast<FD_TweenType>(t) };
+		size_t resolution{ FD_Easing::getTableResolution(type) };
+		double switched{ timeEasing(source, work, repeats, [type](double* p, size_t n) {
+			for (size_t i = 0; i < n; i++) p[i] = switchEase(type, p[i]);
+		}) };
+		FD_Easing::setTableResolution(type, 0);
+		double policy{ timeEasing(source, work, repeats, [type](double* p, size_t n) {
+			FD_Easing::easeAll(type, p, n);
+		}) };
+		FD_Easing::setTableResolution(type, 1024);
+		double table{ timeEasing(source, work, repeats, [type](double* p, size_t n) {
+			FD_Easing::easeAll(type, p, n);
+		}) };
+		FD_Easing::setTableResolution(type, resolution);
+		out << std::left << std::setw(14) << names[t] << std::right
+			<< std::setw(10) << switched << std::setw(10) << policy << std::setw(10) << table << "\n";
+	}
+	return out.str();
+}
+
+// Runs the benchmark
+std::string FD_Benchmark::run(Uint32 ticks, Uint32 ups, bool threaded) {
+	// Create a hidden window with a software renderer and no vsync
+	std::shared_ptr<FD_Window> window{ std::make_shared<FD_Window>("Fluxdrive Benchmark",
+		640, 360, SDL_WINDOW_HIDDEN,
+		SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE) };
+	std::shared_ptr<FD_Scene> scene{ std::make_shared<FD_Scene>(window, false, 640, 360) };
+	scene->setJobSystem(std::make_shared<FD_JobSystem>());
+	// Batching is off by default, but its draw calls are counted below
+	scene->setSpriteBatching(true);
+	// Create the states and state manager
+	std::shared_ptr<FD_StateManager> state_manager{ std::make_shared<FD_StateManager>(scene) };
+	std::shared_ptr<FD_BenchmarkState> world{ std::make_shared<FD_BenchmarkState>(
+		FD_BENCHMARK_WORLD_STATE, scene, 1, 2000, 200, true,
+		ticks / 3, FD_BENCHMARK_SCROLLING_STATE) };
+	// A world mostly off camera, culled by a spatial index
+	std::shared_ptr<FD_BenchmarkState> scrolling{ std::make_shared<FD_BenchmarkState>(
+		FD_BENCHMARK_SCROLLING_STATE, scene, 1, 20000, 2000, true,
+		ticks / 3, FD_BENCHMARK_HUD_STATE, 10, true) };
+	std::shared_ptr<FD_BenchmarkState> hud{ std::make_shared<FD_BenchmarkState>(
+		FD_BENCHMARK_HUD_STATE, scene, 8, 50, 10, false,
+		ticks - 2 * (ticks / 3)) };
+	state_manager->logState(world);
+	state_manager->logState(scrolling);
+	state_manager->logState(hud);
+	state_manager->setState(FD_BENCHMARK_WORLD_STATE);
+	// Record the phases of the loop
+	std::shared_ptr<FD_FrameStats> stats{ std::make_shared<FD_FrameStats>() };
+	scene->setFrameStats(stats);
+	std::shared_ptr<FD_Looper> looper{ std::make_shared<FD_Looper>(state_manager, ups) };
+	looper->setFrameStats(stats);
+	looper->setThreadedUpdate(threaded);
+	looper->loop();
+	const FD_RenderState& state{ window->getRenderState() };
+	const FD_SpriteBatch& sprites{ scene->getSpriteBatch() };
+	const FD_PrimitiveBatch& primitives{ scene->getPrimitiveBatch() };
+	return stats->report() + "Render state changes issued " + std::to_string(state.getIssuedCount())
+		+ ", skipped " + std::to_string(state.getSkippedCount()) + "\n"
+		+ "Sprites batched " + std::to_string(sprites.getSpriteCount())
+		+ " in " + std::to_string(sprites.getCallCount()) + " draw calls\n"
+		+ "Primitives batched " + std::to_string(primitives.getPrimitiveCount())
+		+ " in " + std::to_string(primitives.getCallCount()) + " draw calls\n";
+}
+
+// Benchmark State Member Functions
+
+FD_Benchmark::FD_BenchmarkState::FD_BenchmarkState(int id, std::weak_ptr<FD_Scene> s,
+	size_t group_count, size_t element_count, size_t box_count,
+	bool camera_bound, Uint32 tick_limit, int next, double spread, bool indexed)
+	: FD_State(id, s), spread{ spread }, tick_limit{ tick_limit }, next{ next } {
+	FD_Factory* factory{ new FD_Factory(s, arena) };
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(s, scene, true);
+	// Create the camera set and the sheet and animation shared by the elements
+	cameras = factory->generateCameraSet();
+	camera = cameras->addCamera(1920);
+	image = std::make_shared<FD_PureImage>(scene->getWindow()->getRenderer(),
+		64, 32, std::vector<FD_PureElement*>());
+	image->setUnderlayColour({ 255, 255, 255, 255 });
+	clip = FD_AnimationClip::fromGrid(32, 32, 2, 2, 100);
+	// Create the groups, spreading the objects across the camera
+	SDL_Colour colour{ 255, 0, 0, 255 };
+	for (size_t g = 0; g < group_count; g++) {
+		std::shared_ptr<FD_ObjectGroup> group{
+			factory->generateObjectGroup(true, true, object_list) };
+		group->setCameraSet(cameras);
+		group->setSpatialIndex(indexed);
+		groups.push_back(group);
+		for (size_t i = 0; i < element_count; i++) {
+			elements.push_back(factory->generateElement(true, image,
+				random.randomDouble(-960 * spread, 960 * spread),
+				random.randomDouble(-540 * spread, 540 * spread),
+				random.randomDouble(0, 360), random.randomInteger(0, 4),
+				1, -1, camera_bound));
+			elements.back()->play(clip, FD_ANIMATION_LOOP, random.randomDouble(0.5, 2));
+		}
+		for (size_t i = 0; i < box_count; i++) {
+			boxes.push_back(factory->generateBox(true,
+				random.randomDouble(-960 * spread, 960 * spread),
+				random.randomDouble(-540 * spread, 540 * spread),
+				16, 16, random.randomInteger(0, 4), camera_bound, colour));
+		}
+	}
+	delete factory;
+}
+FD_Benchmark::FD_BenchmarkState::~FD_BenchmarkState() {}
+
+void FD_Benchmark::FD_BenchmarkState::wake() {
+	FD_State::wake();
+	ticks = 0;
+}
+
+void FD_Benchmark::FD_BenchmarkState::sleep() {}
+
+void FD_Benchmark::FD_BenchmarkState::update() {
+	ticks++;
+	// Periodically send every element somewhere new
+	bool relocate{ ticks % 60 == 0 };
+	if (relocate) {
+		for (auto& e : elements) {
+			e->getTweenX()->move(FD_TWEEN_EASE_OUT,
+				random.randomDouble(-960 * spread, 960 * spread), 1000);
+			e->getTweenY()->move(FD_TWEEN_EASE_OUT,
+				random.randomDouble(-540 * spread, 540 * spread), 1000);
+		}
+	}
+	// Spin every element, in parallel where possible
+	auto spin = [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			elements[i]->getTweenAngle()->add(1);
+			elements[i]->update();
+		}
+	};
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(this->scene, scene, true);
+	if (auto jobs = scene->getJobSystem()) {
+		jobs->parallelFor(0, elements.size(), 256, spin);
+	} else {
+		spin(0, elements.size());
+	}
+	// Re-layer a few boxes to exercise the object groups
+	for (size_t i = ticks % 10; i < boxes.size(); i += 10) {
+		boxes.at(i)->setLayer(random.randomInteger(0, 4));
+	}
+	if (auto c = cameras->getCurrentCamera().lock()) {
+		if (relocate) c->shake(1);
+	}
+	// Move on once the workload is complete
+	if (ticks >= tick_limit) {
+		if (next == FD_State::INVALID_STATE) {
+			closed = true;
+		} else {
+			nextState = next;
+		}
+	}
+}
+
+void FD_Benchmark::FD_BenchmarkState::resized(int w, int h) {}
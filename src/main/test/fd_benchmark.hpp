@@ -0,0 +1,143 @@
+#ifndef FD_BENCHMARK_H_
+#define FD_BENCHMARK_H_
+
+#include <string>
+
+#include "../../display/fd_scene.hpp"
+#include "../../display/fd_window.hpp"
+#include "../../display/fd_cameraSet.hpp"
+#include "../../state/fd_stateManager.hpp"
+#include "../../object/fd_element.hpp"
+#include "../../object/fd_objectGroup.hpp"
+
+/*!
+	@file
+	@brief The file containing the headless benchmark of the FD_Looper pipeline.
+*/
+
+//! The namespace containing the headless benchmark of the FD_Looper pipeline.
+namespace FD_Benchmark {
+
+	//! The states ran by the benchmark, in order.
+	enum FD_BenchmarkStates {
+		FD_BENCHMARK_WORLD_STATE,
+		FD_BENCHMARK_SCROLLING_STATE,
+		FD_BENCHMARK_HUD_STATE
+	};
+
+	//! A state that animates a fixed workload for a number of ticks.
+	/*!
+		Once the tick limit is reached, the state switches to the next state
+		or, if there is none, closes the program.
+	*/
+	class FD_BenchmarkState : public FD_State {
+	private:
+
+		FD_CameraIndex camera;
+		std::shared_ptr<FD_CameraSet> cameras;
+		std::vector<std::shared_ptr<FD_ObjectGroup>> groups{};
+
+		std::shared_ptr<FD_PureImage> image;
+		std::shared_ptr<const FD_AnimationClip> clip;
+		std::vector<std::shared_ptr<FD_Element>> elements{};
+		std::vector<std::shared_ptr<FD_Box>> boxes{};
+
+		FD_RandomGenerator random{};
+		const double spread;
+		Uint32 ticks{ 0 };
+		const Uint32 tick_limit;
+		const int next;
+
+	public:
+
+		//! Constructs a FD_BenchmarkState.
+		/*!
+			\param id            The ID of the state.
+			\param scene         The scene for the state to use.
+			\param group_count   The number of object groups to create.
+			\param element_count The number of elements to create in each group.
+			\param box_count     The number of boxes to create in each group.
+			\param camera_bound  Whether the objects are drawn relative to the camera.
+			\param tick_limit    The number of updates to run for.
+			\param next          The state to switch to once finished.
+			\param spread        How many camera widths and heights the objects are spread over.
+			\param indexed       Whether the object groups are spatially indexed.
+		*/
+		FD_BenchmarkState(int id, std::weak_ptr<FD_Scene> scene,
+			size_t group_count, size_t element_count, size_t box_count,
+			bool camera_bound, Uint32 tick_limit,
+			int next = FD_State::INVALID_STATE,
+			double spread = 1, bool indexed = false);
+		~FD_BenchmarkState();
+
+		void sleep() override;
+		void wake() override;
+		void update() override;
+
+		void resized(int w, int h) override;
+	};
+
+	//! Runs the benchmark, returning the per-phase timings.
+	/*!
+		This should be ran after FD_Main::initialise, ideally with a headless
+		video driver. The renderer is created without vsync so that the
+		timings reflect the work done by Fluxdrive.
+
+		\param ticks    The total number of updates, split between the states.
+		\param ups      The update rate of the FD_Looper.
+		\param threaded Whether the FD_Looper updates on a separate thread.
+
+		\return A table of the p50, p95 and, p99 timings of each phase, per object list, the number of render state changes skipped and, the draw calls taken by batched sprites and primitives.
+
+		\sa FD_FrameStats
+	*/
+	std::string run(Uint32 ticks = 1200, Uint32 ups = 120, bool threaded = false);
+	//! Runs the easing microbenchmark, returning the time taken per value for each curve.
+	/*!
+		Each curve is applied to the same progresses by a per-value switch,
+		as FD_Tween::value used to, by its compile-time policy and, by a
+		lookup table. This needs no initialisation.
+
+		\param count   The number of progresses eased per pass.
+		\param repeats The number of passes timed.
+
+		\return A table of the nanoseconds per value for each curve and method.
+
+		\sa FD_Easing
+	*/
+	std::string easing(size_t count = 1 << 16, size_t repeats = 200);
+	//! Runs the object group churn microbenchmark, returning the time taken per update.
+	/*!
+		Each update, a share of the objects are released and replaced and, as
+		many again are moved to another layer. The same churn is timed through
+		a single vector kept sorted by layer, as FD_ObjectGroup used to store
+		its objects, and through FD_ObjectGroup. This needs no initialisation.
+
+		\param count The number of objects.
+		\param rate  The share of the objects churned each update, from 0 to 1.
+		\param ticks The number of updates timed.
+
+		\return A table of the milliseconds per update for each storage.
+
+		\sa FD_ObjectGroup
+	*/
+	std::string churn(size_t count = 50000, double rate = 0.1, size_t ticks = 100);
+	//! Packs rectangles across atlas pages and checks the placements, returning the result.
+	/*!
+		Rectangles of random sizes are packed, with some larger than a page
+		mixed among them. The check fails if any rectangle larger than a page
+		is placed, or any placed rectangle leaves its page or overlaps another
+		on the same page. This needs no initialisation.
+
+		\param count The number of rectangles.
+		\param size  The width and height of each page.
+
+		\return The number of pages used, their occupancy and, whether the check passed.
+
+		\sa FD_AtlasPacker::packPages
+	*/
+	std::string atlas(size_t count = 500, int size = 512);
+
+}
+
+#endif
@@ -1,7 +1,124 @@
 #include "fd_testing.hpp"
 
+#include <cstdlib>
+
 #include "../../factory/fd_factory.hpp"
 
+namespace {
+
+	// Reads the colour of a pixel of the current render target
+	SDL_Colour readPixel(SDL_Renderer* renderer, int x, int y) {
+		Uint32 pixel{ 0 };
+		SDL_Rect rect{ x, y, 1, 1 };
+		SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_RGBA8888, &pixel, sizeof(pixel));
+		return { static_cast<Uint8>(pixel >> 24), static_cast<Uint8>(pixel >> 16),
+			static_cast<Uint8>(pixel >> 8), static_cast<Uint8>(pixel) };
+	}
+
+	bool similar(SDL_Colour a, SDL_Colour b) {
+		return std::abs(a.r - b.r) <= 2 && std::abs(a.g - b.g) <= 2 && std::abs(a.b - b.b) <= 2;
+	}
+
+}
+
+// Checks that a group drawn through a cache looks as it would drawn directly
+bool FD_Testing::checkGroupCache(FD_RenderState& state) {
+	SDL_Renderer* renderer{ state.getRenderer() };
+	// The cache can only match where custom blend modes are supported
+	SDL_Texture* probe{ SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+		SDL_TEXTUREACCESS_TARGET, 1, 1) };
+	bool supported{ probe != nullptr
+		&& SDL_SetTextureBlendMode(probe, FD_GroupCache::getCompositeBlendMode()) == 0 };
+	if (probe != nullptr) SDL_DestroyTexture(probe);
+	if (!supported) {
+		FD_Handling::debug("Group cache check skipped, the renderer has no custom blend modes.");
+		return true;
+	}
+	bool passed{ true };
+	for (Uint8 opacity : { Uint8{ 255 }, Uint8{ 128 } }) {
+		// A half transparent box, as its group records it for the cache
+		FD_DrawCommand box{};
+		box.type = FD_DRAW_BOX;
+		box.dstrect = { 0, 0, 16, 16 };
+		box.blend = SDL_BLENDMODE_BLEND;
+		box.underlay_colour = { 200, 100, 50, 128 };
+		// Draw it directly, faded by the group as it is without a cache
+		FD_DrawCommand direct{ box };
+		direct.underlay_colour.a = static_cast<Uint8>(box.underlay_colour.a * (opacity / 255.0));
+		state.invalidate();
+		state.setDrawColour(20, 40, 60, 255);
+		SDL_RenderClear(renderer);
+		direct.execute(state);
+		SDL_Colour expected{ readPixel(renderer, 8, 8) };
+		// Draw it through a cache, faded as the copy
+		FD_GroupCache cache{};
+		FD_RenderSnapshot snapshot{};
+		snapshot.add() = box;
+		cache.submit(snapshot);
+		state.invalidate();
+		state.setDrawColour(20, 40, 60, 255);
+		SDL_RenderClear(renderer);
+		cache.render(state, opacity);
+		SDL_Colour cached{ readPixel(renderer, 8, 8) };
+		if (!similar(expected, cached)) passed = false;
+	}
+	state.invalidate();
+	return passed;
+}
+
+// Checks that packed images stay on their page and, can't draw their neighbours
+bool FD_Testing::checkAtlas(SDL_Renderer* renderer) {
+	const int size{ 64 }, padding{ 2 };
+	// Padded as FD_ImageManager::loadAtlas pads them, tallest first, with one too large
+	std::vector<SDL_Rect> sizes{ { 0, 0, 24, 70 }, { 0, 0, 20, 30 }, { 0, 0, 30, 20 },
+		{ 0, 0, 14, 14 }, { 0, 0, 40, 12 }, { 0, 0, 8, 8 } };
+	std::vector<size_t> pages{};
+	std::vector<SDL_Rect> slots{};
+	std::vector<FD_AtlasPacker> packers{ FD_AtlasPacker::packPages(size, size, sizes, pages, slots) };
+	bool passed{ pages.size() == sizes.size() && slots.size() == sizes.size() };
+	if (!passed) return false;
+	if (pages[0] != FD_AtlasPacker::unpacked) passed = false;
+	for (size_t i = 1; i < sizes.size(); i++) {
+		const SDL_Rect& r{ slots[i] };
+		if (pages[i] >= packers.size() || r.w != sizes[i].w || r.h != sizes[i].h
+			|| r.x < 0 || r.y < 0 || r.x + r.w > size || r.y + r.h > size) {
+			passed = false;
+			continue;
+		}
+		for (size_t j = 1; j < i; j++) {
+			if (pages[j] == pages[i] && SDL_HasIntersection(&slots[j], &r)) passed = false;
+		}
+	}
+	if (!passed || packers.empty()) return false;
+	// View the first page as loadAtlas would and, check the source rectangles keep to each image
+	SDL_Surface* sheet{ SDL_CreateRGBSurfaceWithFormat(0, packers[0].getUsedWidth(),
+		packers[0].getUsedHeight(), 32, SDL_PIXELFORMAT_RGBA32) };
+	if (sheet == nullptr) return false;
+	std::shared_ptr<FD_AtlasImage> atlas{ std::make_shared<FD_AtlasImage>(renderer, sheet) };
+	SDL_FreeSurface(sheet);
+	if (!atlas->isLoaded()) return false;
+	for (size_t i = 1; i < sizes.size(); i++) {
+		if (pages[i] != 0) continue;
+		SDL_Rect region{ slots[i].x + padding, slots[i].y + padding,
+			slots[i].w - 2 * padding, slots[i].h - 2 * padding };
+		FD_FileImage image{ 0, atlas, region };
+		int w{ region.w }, h{ region.h };
+		SDL_Rect whole{ image.getSourceRect(nullptr) };
+		SDL_Rect over{ -4, -4, w + 8, h + 8 };
+		SDL_Rect clamped{ image.getSourceRect(&over) };
+		SDL_Rect corner{ w - 2, h - 2, 10, 10 };
+		SDL_Rect expected{ region.x + w - 2, region.y + h - 2, 2, 2 };
+		SDL_Rect cornered{ image.getSourceRect(&corner) };
+		SDL_Rect outside{ w + 1, 0, 4, 4 };
+		SDL_Rect nothing{ image.getSourceRect(&outside) };
+		if (!SDL_RectEquals(&whole, &region) || !SDL_RectEquals(&clamped, &region)
+			|| !SDL_RectEquals(&cornered, &expected) || (nothing.w > 0 && nothing.h > 0)) {
+			passed = false;
+		}
+	}
+	return passed;
+}
+
 // Runs the test suite
 void FD_Testing::test() {
 	// Print SDL version
@@ -17,6 +134,11 @@ void FD_Testing::test() {
 	FD_Handling::debug(("Tests are linking on SDL version   : " + lv).c_str());
 	// Create the window
 	std::shared_ptr<FD_Window> window{ std::make_shared<FD_Window>("Fluxdrive Test", 640, 360) };
+	// Run the checks that need no input
+	FD_Handling::debug(checkGroupCache(window->getRenderState())
+		? "Group cache check passed." : "Group cache check FAILED.");
+	FD_Handling::debug(checkAtlas(window->getRenderer())
+		? "Atlas check passed." : "Atlas check FAILED.");
 	// Create the scene
 #ifdef FD_TEST_MANUAL_SCENE
 	std::shared_ptr<FD_Scene> scene{ std::make_shared<FD_Scene>(window, false, 1280, 720) };
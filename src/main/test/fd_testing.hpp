@@ -4,6 +4,8 @@
 #include "../../display/fd_scene.hpp"
 #include "../../display/fd_window.hpp"
 #include "../../display/fd_cameraSet.hpp"
+#include "../../display/fd_groupCache.hpp"
+#include "../../input/fd_atlasPacker.hpp"
 #include "../../state/fd_stateManager.hpp"
 #include "../../object/fd_objectGroup.hpp"
 #include "../../object/ui/fd_text.hpp"
@@ -241,6 +243,9 @@ namespace FD_Testing {
 		void resized(int w, int h) override;
 	};
 
+	bool checkGroupCache(FD_RenderState& state);
+	bool checkAtlas(SDL_Renderer* renderer);
+
 	void test();
 
 }
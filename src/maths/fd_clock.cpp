@@ -0,0 +1,63 @@
+#include "fd_clock.hpp"
+
+#include <mutex>
+#include <atomic>
+
+#include <SDL_timer.h>
+
+namespace {
+
+	// The time read by everything, updated on each advance
+	std::atomic<Uint32> ticks{ 0 };
+	// The unrounded engine time and the real time of the last advance
+	double elapsed{ 0 };
+	Uint64 last_counter{ 0 };
+	bool started{ false };
+	std::mutex advance_mutex;
+
+	std::atomic<FD_ClockMode> mode{ FD_CLOCK_REAL };
+	std::atomic<double> scale{ 1 };
+	std::atomic<bool> paused{ false };
+
+}
+
+Uint32 FD_Clock::getTicks() { return ticks.load(std::memory_order_relaxed); }
+void FD_Clock::advance() {
+	std::lock_guard<std::mutex> lock{ advance_mutex };
+	Uint64 counter{ SDL_GetPerformanceCounter() };
+	// Begin counting from the first advance
+	if (!started) {
+		started = true;
+		last_counter = counter;
+		return;
+	}
+	double passed{ static_cast<double>(counter - last_counter) * 1000.0
+		/ static_cast<double>(SDL_GetPerformanceFrequency()) };
+	last_counter = counter;
+	if (mode == FD_CLOCK_STEPPED || paused) return;
+	elapsed += passed * scale;
+	ticks.store(static_cast<Uint32>(elapsed), std::memory_order_relaxed);
+}
+void FD_Clock::step(double ms) {
+	std::lock_guard<std::mutex> lock{ advance_mutex };
+	elapsed += ms;
+	ticks.store(static_cast<Uint32>(elapsed), std::memory_order_relaxed);
+}
+void FD_Clock::set(Uint32 ms) {
+	std::lock_guard<std::mutex> lock{ advance_mutex };
+	elapsed = ms;
+	ticks.store(ms, std::memory_order_relaxed);
+}
+
+void FD_Clock::setMode(FD_ClockMode mode) { ::mode = mode; }
+FD_ClockMode FD_Clock::getMode() { return mode; }
+void FD_Clock::setScale(double scale) { ::scale = scale < 0 ? 0 : scale; }
+double FD_Clock::getScale() { return scale; }
+void FD_Clock::setPaused(bool paused) { ::paused = paused; }
+bool FD_Clock::isPaused() { return paused; }
+void FD_Clock::reset() {
+	std::lock_guard<std::mutex> lock{ advance_mutex };
+	elapsed = 0;
+	started = false;
+	ticks.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,90 @@
+#ifndef FD_CLOCK_H_
+#define FD_CLOCK_H_
+
+#include <SDL_stdinc.h>
+
+/*!
+	@file
+	@brief A file containing the FD_Clock namespace, the time read by tweens, timers and, noise.
+*/
+
+//! The enumeration containing the ways FD_Clock can advance.
+enum FD_ClockMode {
+	//! Advances by the real time passed, multiplied by the time scale.
+	FD_CLOCK_REAL,
+	//! Only advances when stepped, for headless tests and replays.
+	FD_CLOCK_STEPPED
+};
+
+//! The namespace containing the engine clock.
+/*!
+	The clock is read rather than the system time so that every read made
+	between two advances agrees, meaning a frame never sees two different
+	times and reading it costs nothing. FD_Looper advances it once before each
+	update and, when updates share its thread, before each frame. Time starts
+	at zero on the first advance, so time spent loading is not counted.
+
+	\sa FD_Looper
+*/
+namespace FD_Clock {
+
+	//! Returns the current engine time.
+	/*!
+		\return The engine time in milliseconds.
+	*/
+	Uint32 getTicks();
+	//! Moves the engine time forward by the real time passed since the last advance.
+	/*!
+		The time passed is multiplied by the time scale and, ignored if the
+		clock is paused or stepped.
+	*/
+	void advance();
+	//! Moves the engine time forward by a given amount, in any mode.
+	/*!
+		\param ms The time to move forward in milliseconds, which is not scaled.
+	*/
+	void step(double ms);
+	//! Sets the engine time, in any mode.
+	/*!
+		\param ms The engine time in milliseconds.
+	*/
+	void set(Uint32 ms);
+
+	//! Sets how the clock advances.
+	/*!
+		\param mode The clock mode.
+
+		\sa FD_ClockMode
+	*/
+	void setMode(FD_ClockMode mode);
+	//! Returns how the clock advances.
+	/*!
+		\return The clock mode.
+	*/
+	FD_ClockMode getMode();
+	//! Sets the rate at which the engine time passes, relative to real time.
+	/*!
+		\param scale The time scale, with 1 passing in real time.
+	*/
+	void setScale(double scale);
+	//! Returns the rate at which the engine time passes, relative to real time.
+	/*!
+		\return The time scale.
+	*/
+	double getScale();
+	//! Sets whether the clock is paused, stopping advances.
+	/*!
+		\param paused Whether the clock is paused.
+	*/
+	void setPaused(bool paused);
+	//! Returns whether the clock is paused.
+	/*!
+		\return Whether the clock is paused.
+	*/
+	bool isPaused();
+	//! Sets the engine time back to zero, starting again from the next advance.
+	void reset();
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include "fd_easing.hpp"
+
+#include "../main/fd_handling.hpp"
+
+namespace {
+
+	// The lookup table of each type of tween, empty when calculated exactly
+	FD_Easing::FD_EasingTable tables[FD_Easing::type_count]{};
+
+	template <class Curve>
+	void easeCurve(FD_TweenType type, double* progress, size_t count) {
+		if (tables[type].isBuilt()) {
+			tables[type].easeAll(progress, count);
+		} else {
+			FD_Easing::easeAll<Curve>(progress, count);
+		}
+	}
+
+}
+
+void FD_Easing::easeAll(FD_TweenType type, double* progress, size_t count) {
+	switch (type) {
+	case FD_TWEEN_LINEAR: return easeCurve<Linear>(type, progress, count);
+	case FD_TWEEN_EASE_IN: return easeCurve<In>(type, progress, count);
+	case FD_TWEEN_EASE_OUT: return easeCurve<Out>(type, progress, count);
+	case FD_TWEEN_ELASTIC: return easeCurve<Elastic>(type, progress, count);
+	case FD_TWEEN_CUBIC_BEZIER: return easeCurve<CubicBezier>(type, progress, count);
+	case FD_TWEEN_SPRING: return easeCurve<Spring>(type, progress, count);
+	}
+	FD_Handling::debug("Unhandled tween.");
+}
+double FD_Easing::ease(FD_TweenType type, double progress) {
+	easeAll(type, &progress, 1);
+	return progress;
+}
+
+void FD_Easing::setTableResolution(FD_TweenType type, size_t resolution) {
+	switch (type) {
+	case FD_TWEEN_LINEAR: return tables[type].build<Linear>(resolution);
+	case FD_TWEEN_EASE_IN: return tables[type].build<In>(resolution);
+	case FD_TWEEN_EASE_OUT: return tables[type].build<Out>(resolution);
+	case FD_TWEEN_ELASTIC: return tables[type].build<Elastic>(resolution);
+	case FD_TWEEN_CUBIC_BEZIER: return tables[type].build<CubicBezier>(resolution);
+	case FD_TWEEN_SPRING: return tables[type].build<Spring>(resolution);
+	}
+	FD_Handling::debug("Unhandled tween.");
+}
+size_t FD_Easing::getTableResolution(FD_TweenType type) {
+	return tables[type].getResolution();
+}
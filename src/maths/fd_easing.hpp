@@ -0,0 +1,177 @@
+#ifndef FD_EASING_H_
+#define FD_EASING_H_
+
+#include <math.h>
+#include <vector>
+
+#include "fd_tween.hpp"
+
+/*!
+	@file
+	@brief The file containing the FD_Easing namespace, the curves followed by tweens.
+*/
+
+//! The namespace containing the curves followed by tweens.
+/*!
+	Each curve is a policy with a static ease function, taking how far a tween
+	is through its duration, from 0 to 1, and returning how far its value is.
+	Curves are applied to whole arrays by easeAll, which is specialised for
+	each policy at compile time, so the per-value work is inlined with no
+	dispatch. Expensive curves can instead be read from a lookup table.
+
+	\sa FD_TweenPool
+*/
+namespace FD_Easing {
+
+	//! The number of types of tween.
+	const size_t type_count{ 6 };
+
+	//! Moves proportionally to time passed.
+	struct Linear {
+		static double ease(double p) { return p; }
+	};
+	//! Starts slowly and, speeds up (cubic).
+	struct In {
+		static double ease(double p) { return p * p * p; }
+	};
+	//! Starts quickly and, slows down (cubic).
+	struct Out {
+		static double ease(double p) {
+			double q{ 1 - p };
+			return 1 - q * q * q;
+		}
+	};
+	//! Overshoots and, oscillates into place.
+	struct Elastic {
+		static double ease(double p) {
+			const double period{ 0.3 };
+			return pow(2, -10 * p) * sin((p - period / 4) * (2 * 3.14159) / period) + 1;
+		}
+	};
+	//! Follows the cubic bezier curve from (0, 0) to (1, 1) with the control points of CSS's ease.
+	struct CubicBezier {
+		static constexpr double x1{ 0.25 }, y1{ 0.1 }, x2{ 0.25 }, y2{ 1 };
+		static double ease(double p) {
+			// Solve x(t) = p for t by Newton's method, then return y(t)
+			const double cx{ 3 * x1 }, bx{ 3 * (x2 - x1) - cx }, ax{ 1 - cx - bx };
+			const double cy{ 3 * y1 }, by{ 3 * (y2 - y1) - cy }, ay{ 1 - cy - by };
+			double t{ p };
+			for (int i = 0; i < 8; i++) {
+				double x{ ((ax * t + bx) * t + cx) * t - p };
+				double dx{ (3 * ax * t + 2 * bx) * t + cx };
+				if (fabs(x) < 1e-7 || fabs(dx) < 1e-7) break;
+				t -= x / dx;
+			}
+			return ((ay * t + by) * t + cy) * t;
+		}
+	};
+	//! Springs into place like an underdamped spring, ending exactly at the destination.
+	struct Spring {
+		static constexpr double damping{ 0.35 }, frequency{ 14 };
+		static double ease(double p) {
+			const double decay{ damping * frequency };
+			const double damped{ frequency * sqrt(1 - damping * damping) };
+			auto spring = [&](double t) {
+				return 1 - exp(-decay * t) * (cos(damped * t) + decay / damped * sin(damped * t));
+			};
+			// Correct the small remaining displacement so the curve ends at 1
+			return spring(p) + p * (1 - spring(1));
+		}
+	};
+
+	//! Applies a curve to an array of progresses.
+	/*!
+		\param progress The progresses, from 0 to 1, replaced by the eased values.
+		\param count    The number of progresses.
+	*/
+	template <class Curve>
+	void easeAll(double* progress, size_t count) {
+		for (size_t i = 0; i < count; i++) progress[i] = Curve::ease(progress[i]);
+	}
+
+	//! The class containing a curve sampled at even intervals.
+	class FD_EasingTable {
+	private:
+
+		std::vector<double> samples{};
+
+	public:
+
+		//! Samples a curve.
+		/*!
+			\param resolution The number of intervals sampled, or 0 to empty the table.
+		*/
+		template <class Curve>
+		void build(size_t resolution) {
+			samples.clear();
+			if (resolution == 0) return;
+			samples.resize(resolution + 1);
+			for (size_t i = 0; i <= resolution; i++) {
+				samples[i] = Curve::ease(static_cast<double>(i) / static_cast<double>(resolution));
+			}
+		}
+		//! Returns whether the table has been built.
+		/*!
+			\return Whether the table holds samples.
+		*/
+		bool isBuilt() const { return !samples.empty(); }
+		//! Returns the number of intervals sampled.
+		/*!
+			\return The resolution of the table.
+		*/
+		size_t getResolution() const { return samples.empty() ? 0 : samples.size() - 1; }
+		//! Applies the sampled curve to an array of progresses, interpolating between samples.
+		/*!
+			\param progress The progresses, from 0 to 1, replaced by the eased values.
+			\param count    The number of progresses.
+		*/
+		void easeAll(double* progress, size_t count) const {
+			const double scale{ static_cast<double>(samples.size() - 1) };
+			const size_t last{ samples.size() - 2 };
+			for (size_t i = 0; i < count; i++) {
+				double position{ progress[i] * scale };
+				size_t index{ static_cast<size_t>(position) };
+				if (index > last) index = last;
+				double fraction{ position - static_cast<double>(index) };
+				progress[i] = samples[index] + (samples[index + 1] - samples[index]) * fraction;
+			}
+		}
+	};
+
+	//! Applies the curve of a type of tween to an array of progresses, using its table if it has one.
+	/*!
+		\param type     The type of tween.
+		\param progress The progresses, from 0 to 1, replaced by the eased values.
+		\param count    The number of progresses.
+	*/
+	void easeAll(FD_TweenType type, double* progress, size_t count);
+	//! Applies the curve of a type of tween to a progress, using its table if it has one.
+	/*!
+		\param type     The type of tween.
+		\param progress The progress, from 0 to 1.
+
+		\return The eased value.
+	*/
+	double ease(FD_TweenType type, double progress);
+
+	//! Sets whether the curve of a type of tween is read from a lookup table and, its resolution.
+	/*!
+		Tables trade a little accuracy for avoiding calls such as pow, sin and,
+		exp, so are worth using for the elastic, bezier and, spring curves.
+		This should not be called whilst tweens are being evaluated.
+
+		\param type       The type of tween.
+		\param resolution The number of intervals sampled, or 0 to calculate the curve exactly.
+	*/
+	void setTableResolution(FD_TweenType type, size_t resolution);
+	//! Returns the resolution of the lookup table for a type of tween.
+	/*!
+		\param type The type of tween.
+
+		\return The number of intervals sampled, or 0 if the curve is calculated exactly.
+	*/
+	size_t getTableResolution(FD_TweenType type);
+
+}
+
+#endif
@@ -9,7 +9,7 @@
 */
 
 //! The defined value of PI used by Fluxdrive.
-#define FD_PI 3.14159
+#define FD_PI 3.14159265358979323846
 
 //! The structure defining a Fluxdrive point.
 typedef struct FD_Point_ {
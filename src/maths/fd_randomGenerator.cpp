@@ -2,15 +2,36 @@
 
 #include <cmath>
 
+#include "../maths/fd_clock.hpp"
 #include "../maths/fd_maths.hpp"
 
+std::atomic<bool> FD_RandomGenerator::seeded{ false };
+std::atomic<Uint32> FD_RandomGenerator::default_seed{ 0 };
+std::atomic<Uint32> FD_RandomGenerator::seed_count{ 0 };
+
 FD_RandomGenerator::FD_RandomGenerator(Uint32 noise_delta) : noise_delta{ noise_delta } {
 	noise_1 = randomDouble(-1, 1);
 	noise_2 = randomDouble(-1, 1);
-	last_ticks = SDL_GetTicks();
+	last_ticks = FD_Clock::getTicks();
 }
 FD_RandomGenerator::~FD_RandomGenerator() { }
 
+Uint32 FD_RandomGenerator::nextSeed() {
+	if (seeded) return default_seed + seed_count++;
+	return device();
+}
+void FD_RandomGenerator::setSeed(Uint32 seed) {
+	generator.seed(seed);
+}
+void FD_RandomGenerator::setDefaultSeed(Uint32 seed) {
+	default_seed = seed;
+	seed_count = 0;
+	seeded = true;
+}
+void FD_RandomGenerator::clearDefaultSeed() {
+	seeded = false;
+}
+
 int FD_RandomGenerator::randomInteger(int v1, int v2) {
 	return static_cast<int>(floor(randomDouble(v1, v2)));
 }
@@ -20,7 +41,7 @@ double FD_RandomGenerator::randomDouble(double v1, double v2) {
 }
 
 double FD_RandomGenerator::getNoise() {
-	Uint32 ticks = SDL_GetTicks();
+	Uint32 ticks = FD_Clock::getTicks();
 	Uint32 diff = ticks - last_ticks;
 	if (diff > noise_delta) {
 		if (diff > 2 * noise_delta) {
@@ -1,9 +1,10 @@
 #ifndef FD_RANDOM_GEN_H_
 #define FD_RANDOM_GEN_H_
 
+#include <atomic>
 #include <random>
 
-#include <SDL_timer.h>
+#include <SDL_stdinc.h>
 
 /*!
 	@file
@@ -16,7 +17,15 @@ private:
 
 	// For random generation
 	std::random_device device;
-	std::mt19937 generator{ device() };
+	std::mt19937 generator{ nextSeed() };
+
+	// For seeding new generators deterministically
+	static std::atomic<bool> seeded;
+	static std::atomic<Uint32> default_seed;
+	static std::atomic<Uint32> seed_count;
+
+	// Gets the seed for a new generator
+	Uint32 nextSeed();
 
 	// The last recorded tick
 	Uint32 last_ticks;
@@ -40,6 +49,27 @@ public:
 	//! Destroys the FD_RandomGenerator.
 	~FD_RandomGenerator();
 
+	//! Seeds the generator.
+	/*!
+		\param seed The seed to use.
+	*/
+	void setSeed(Uint32 seed);
+	//! Makes generators constructed afterwards seeded deterministically.
+	/*!
+		Each new generator is given the seed plus the number of generators
+		constructed since the seed was set, so a program constructing them in
+		the same order generates the same numbers.
+		Noise follows the engine clock, so it is also deterministic when
+		the clock is stepped.
+
+		\param seed The seed for the next generator.
+
+		\sa clearDefaultSeed
+	*/
+	static void setDefaultSeed(Uint32 seed);
+	//! Makes generators constructed afterwards seeded by the random device.
+	static void clearDefaultSeed();
+
 	//! Generates random integers between v1 (inclusive) and v2 (exclusive).
 	/*!
 		\param v1 The lower bound for the number to be generated.
@@ -60,7 +90,7 @@ public:
 	//! Returns the current noise value.
 	/*!
 		This function generates pseudo-Perlin noise and is based
-		off of the SDL_Ticks function provided by SDL.
+		off of the engine time given by FD_Clock.
 
 		\returns The current noise value.
 	*/
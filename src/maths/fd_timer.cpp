@@ -1,10 +1,12 @@
 #include "fd_timer.hpp"
 
+#include "fd_clock.hpp"
+
 FD_Timer::FD_Timer() {}
 FD_Timer::~FD_Timer() {}
 
 void FD_Timer::start(Uint32 ms) {
-	this->start_time = SDL_GetTicks();
+	this->start_time = FD_Clock::getTicks();
 	this->length = ms;
 }
 
@@ -13,5 +15,5 @@ bool FD_Timer::finished() const {
 }
 
 Uint32 FD_Timer::progress() const {
-	return (SDL_GetTicks() - start_time);
+	return (FD_Clock::getTicks() - start_time);
 }
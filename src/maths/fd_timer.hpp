@@ -1,7 +1,6 @@
 #ifndef FD_TIMER_HPP_
 #define FD_TIMER_HPP_
 
-#include "SDL_timer.h"
 #include "SDL_stdinc.h"
 
 /*!
@@ -9,7 +8,10 @@
 	@brief The file containing the class allowing for basic timing.
 */
 
-//! The class for basic timing.
+//! The class for basic timing, against the engine clock.
+/*!
+	\sa FD_Clock
+*/
 class FD_Timer {
 private:
 
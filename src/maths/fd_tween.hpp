@@ -19,7 +19,11 @@ enum FD_TweenType {
 	//! An ease out tween.
 	FD_TWEEN_EASE_OUT,
 	//! An elastic tween, do not use if you are wary of overshooting (albeit temporarily) the destination.
-	FD_TWEEN_ELASTIC
+	FD_TWEEN_ELASTIC,
+	//! A cubic bezier tween, following the curve of CSS's ease.
+	FD_TWEEN_CUBIC_BEZIER,
+	//! A spring tween, which also overshoots the destination before settling.
+	FD_TWEEN_SPRING
 };
 
 //! The struct detailing a type of tween 'action' (movement).
@@ -45,28 +49,18 @@ typedef struct FD_TweenAction_ {
 } FD_TweenAction;
 
 //! The class allowing smooth interpolation between numerical values.
+/*!
+	A FD_Tween is a handle to a slot of FD_TweenPool, which evaluates every
+	moving tween once per advance of the engine clock. Reading the value of a
+	tween is therefore a load rather than a calculation.
+
+	\sa FD_TweenPool
+*/
 class FD_Tween {
 private:
 
-	// The type of tween
-	FD_TweenType tweenType{ FD_TWEEN_LINEAR };
-	// The starting time and the duration
-	Uint32 start_time{ 0 }, duration{ 0 };
-	// The source and destination values
-	double start_value{ 0 }, end_value{ 0 };
-	// Variables for detecting whether the tween 
-	// has moved since it was last checked
-	Uint32 last_checked{ 0 };
-	bool force_moved{ true };
-	// Whether we have declared that the tween has ended
-	bool has_finished{ false };
-
-	Uint32 getProgress();
-
-	static double linearTween(double s, double e, Uint32 t, Uint32 d);
-	static double easeInTween(double s, double e, Uint32 t, Uint32 d);
-	static double easeOutTween(double s, double e, Uint32 t, Uint32 d);
-	static double elasticTween(double s, double e, Uint32 t, Uint32 d);
+	// The slot of the tween in the pool
+	Uint32 slot;
 
 public:
 
@@ -75,7 +69,31 @@ public:
 		\param value The starting value of the tween.
 	*/
 	FD_Tween(double value = 0);
-	//! Destroys the FD_Tween.
+	//! Constructs a FD_Tween with the same state as another.
+	/*!
+		\param other The tween to copy.
+	*/
+	FD_Tween(const FD_Tween& other);
+	//! Constructs a FD_Tween, taking the slot of another.
+	/*!
+		\param other The tween to take the slot of.
+	*/
+	FD_Tween(FD_Tween&& other) noexcept;
+	//! Copies the state of another tween.
+	/*!
+		\param other The tween to copy.
+
+		\return This tween.
+	*/
+	FD_Tween& operator=(const FD_Tween& other);
+	//! Exchanges slots with another tween.
+	/*!
+		\param other The tween to exchange with.
+
+		\return This tween.
+	*/
+	FD_Tween& operator=(FD_Tween&& other) noexcept;
+	//! Destroys the FD_Tween, freeing its slot.
 	~FD_Tween();
 	
 	//! Sets the value of the tween.
@@ -122,12 +140,12 @@ public:
 	/*!
 		\return The value of the current destination of the tween.
 	*/
-	double destination();
+	double destination() const;
 	//! Returns the current value of the tween.
 	/*!
 		\return The current value of the tween.
 	*/
-	double value();
+	double value() const;
 
 	//! Returns whether the tween has moved since it was lasted checked.
 	/*!
@@ -136,6 +154,18 @@ public:
 		\warning This is not a const operation.
 	*/
 	bool moved();
+	//! Returns whether the tween has changed value since a given time.
+	/*!
+		Unlike moved, this doesn't count as a check, so any number of classes
+		can ask it of the same tween.
+
+		\param ticks The engine time to check from.
+
+		\return Whether the tween has changed value since the time.
+
+		\sa FD_Clock::getTicks
+	*/
+	bool changedSince(Uint32 ticks) const;
 	//! Returns whether the destination of the tween is equal to the given value.
 	/*!
 		\param value The destination to check.
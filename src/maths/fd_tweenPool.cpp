@@ -0,0 +1,265 @@
+#include "fd_tweenPool.hpp"
+
+#include "fd_clock.hpp"
+#include "fd_tweenTimeline.hpp"
+#include "../main/fd_handling.hpp"
+#include "../main/fd_profiler.hpp"
+
+FD_TweenPool::FD_TweenPool() {}
+FD_TweenPool::~FD_TweenPool() {}
+
+FD_TweenPool& FD_TweenPool::get() {
+	static FD_TweenPool pool{};
+	return pool;
+}
+
+FD_TweenPool::Block& FD_TweenPool::block(Uint32 slot) const {
+	return *blocks[slot >> block_bits];
+}
+Uint32 FD_TweenPool::getProgress(const Block& b, Uint32 i, Uint32 now) const {
+	int progress = static_cast<int>(now - b.start_time[i]);
+	if (progress <= 0) return 0;
+	Uint32 uprogress = static_cast<Uint32>(progress);
+	if (uprogress > b.duration[i]) uprogress = b.duration[i];
+	return uprogress;
+}
+double FD_TweenPool::compute(const Block& b, Uint32 i, Uint32 now) const {
+	if (b.type[i] == still) return b.end_value[i];
+	Uint32 progress{ getProgress(b, i, now) };
+	if (progress == 0) return b.start_value[i];
+	double eased{ FD_Easing::ease(static_cast<FD_TweenType>(b.type[i]),
+		static_cast<double>(progress) / static_cast<double>(b.duration[i])) };
+	return b.start_value[i] + eased * (b.end_value[i] - b.start_value[i]);
+}
+void FD_TweenPool::list(Uint32 slot) {
+	Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	Uint8 bit{ static_cast<Uint8>(1 << b.type[i]) };
+	std::lock_guard<std::mutex> lock{ mutex };
+	// A tween stays listed under each type it has had until evaluated
+	if (b.listed[i] & bit) return;
+	b.listed[i] |= bit;
+	active[b.type[i]].push_back(slot);
+}
+
+Uint32 FD_TweenPool::allocate(double value) {
+	Uint32 slot{ none };
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		if (!free_slots.empty()) {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		} else {
+			if ((size & (block_size - 1)) == 0) {
+				if ((size >> block_bits) >= max_blocks) {
+					FD_Handling::error("The tween pool is full.", true);
+				}
+				blocks[size >> block_bits] = std::make_unique<Block>();
+			}
+			slot = size++;
+		}
+	}
+	set(slot, value);
+	return slot;
+}
+void FD_TweenPool::release(Uint32 slot) {
+	if (slot == none) return;
+	// Stop evaluating the slot, leaving any listings to be removed then
+	block(slot).type[slot & (block_size - 1)] = still;
+	std::lock_guard<std::mutex> lock{ mutex };
+	free_slots.push_back(slot);
+}
+void FD_TweenPool::copy(Uint32 slot, Uint32 source) {
+	Block& b{ block(slot) };
+	const Block& s{ block(source) };
+	Uint32 i{ slot & (block_size - 1) }, j{ source & (block_size - 1) };
+	b.type[i] = s.type[j];
+	b.force_moved[i] = s.force_moved[j];
+	b.has_finished[i] = s.has_finished[j];
+	b.start_time[i] = s.start_time[j];
+	b.duration[i] = s.duration[j];
+	b.last_checked[i] = s.last_checked[j];
+	b.changed_at[i] = FD_Clock::getTicks();
+	b.start_value[i] = s.start_value[j];
+	b.end_value[i] = s.end_value[j];
+	b.value[i] = s.value[j];
+	if (b.type[i] != still) list(slot);
+}
+
+void FD_TweenPool::set(Uint32 slot, double value) {
+	Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	b.force_moved[i] = true;
+	b.last_checked[i] = 0;
+	b.changed_at[i] = FD_Clock::getTicks();
+	b.type[i] = still;
+	b.start_time[i] = 0;
+	b.duration[i] = 0;
+	b.start_value[i] = b.end_value[i] = b.value[i] = value;
+	b.has_finished[i] = false;
+}
+void FD_TweenPool::add(Uint32 slot, double value) {
+	if (value == 0) return;
+	Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	b.start_value[i] += value;
+	b.end_value[i] += value;
+	b.value[i] += value;
+	b.force_moved[i] = true;
+	b.last_checked[i] = getProgress(b, i, FD_Clock::getTicks());
+	b.changed_at[i] = FD_Clock::getTicks();
+}
+void FD_TweenPool::move(Uint32 slot, FD_TweenType type, double destination,
+	Uint32 duration, Uint32 pause) {
+	if (duration == 0) {
+		set(slot, destination);
+		return;
+	}
+	Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	// Tween to the value from the current position
+	b.start_value[i] = b.value[i] = value(slot);
+	b.force_moved[i] = true;
+	b.last_checked[i] = 0;
+	b.changed_at[i] = FD_Clock::getTicks();
+	b.type[i] = static_cast<Uint8>(type);
+	b.duration[i] = duration;
+	b.start_time[i] = FD_Clock::getTicks() + pause;
+	b.end_value[i] = destination;
+	b.has_finished[i] = false;
+	list(slot);
+}
+
+double FD_TweenPool::value(Uint32 slot) const {
+	const Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	Uint32 now{ FD_Clock::getTicks() };
+	// Work the value out if the clock has moved on since the last evaluation
+	if (evaluated && evaluated_at == now) return b.value[i];
+	return compute(b, i, now);
+}
+double FD_TweenPool::destination(Uint32 slot) const {
+	return block(slot).end_value[slot & (block_size - 1)];
+}
+bool FD_TweenPool::moved(Uint32 slot) {
+	Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	Uint32 progress{ getProgress(b, i, FD_Clock::getTicks()) };
+	bool moved{ false };
+	if (b.force_moved[i]) {
+		b.force_moved[i] = false;
+		moved = true;
+	} else {
+		moved = progress != b.last_checked[i];
+	}
+	b.last_checked[i] = progress;
+	return moved;
+}
+bool FD_TweenPool::changedSince(Uint32 slot, Uint32 ticks) const {
+	const Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	if (static_cast<int>(b.changed_at[i] - ticks) >= 0) return true;
+	// Otherwise it changed only if it was moving at some point since
+	if (b.duration[i] == 0) return false;
+	Uint32 now{ FD_Clock::getTicks() };
+	Uint32 end{ b.start_time[i] + b.duration[i] };
+	return static_cast<int>(now - b.start_time[i]) > 0 && static_cast<int>(end - ticks) > 0;
+}
+bool FD_TweenPool::done(Uint32 slot) const {
+	const Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	return FD_Clock::getTicks() - b.start_time[i] >= b.duration[i];
+}
+bool FD_TweenPool::finished(Uint32 slot) {
+	Block& b{ block(slot) };
+	Uint32 i{ slot & (block_size - 1) };
+	if (b.has_finished[i] || getProgress(b, i, FD_Clock::getTicks()) != b.duration[i]) return false;
+	b.has_finished[i] = true;
+	return true;
+}
+
+void FD_TweenPool::evaluate() {
+	FD_PROFILE_ZONE("FD_TweenPool::evaluate");
+	Uint32 now{ FD_Clock::getTicks() };
+	for (size_t type = 0; type < type_count; type++) {
+		std::vector<Uint32>& listed{ active[type] };
+		Uint8 bit{ static_cast<Uint8>(1 << type) };
+		scratch_index.clear();
+		scratch_progress.clear();
+		// Gather the progress of each tween, unlisting those that have stopped
+		size_t kept{ 0 };
+		for (size_t k = 0; k < listed.size(); k++) {
+			Uint32 slot{ listed[k] };
+			Block& b{ block(slot) };
+			Uint32 i{ slot & (block_size - 1) };
+			if (b.type[i] != type) {
+				b.listed[i] &= ~bit;
+				continue;
+			}
+			Uint32 progress{ getProgress(b, i, now) };
+			if (progress >= b.duration[i]) {
+				b.listed[i] &= ~bit;
+			} else {
+				listed[kept++] = slot;
+			}
+			scratch_index.push_back(slot);
+			scratch_progress.push_back(static_cast<double>(progress)
+				/ static_cast<double>(b.duration[i]));
+		}
+		listed.resize(kept);
+		// Ease every progress of this type in one pass
+		double* p{ scratch_progress.data() };
+		size_t count{ scratch_progress.size() };
+		FD_Easing::easeAll(static_cast<FD_TweenType>(type), p, count);
+		// Write the values back
+		for (size_t k = 0; k < count; k++) {
+			Block& b{ block(scratch_index[k]) };
+			Uint32 i{ scratch_index[k] & (block_size - 1) };
+			b.value[i] = b.start_value[i] + p[k] * (b.end_value[i] - b.start_value[i]);
+		}
+	}
+	evaluated_at = now;
+	evaluated = true;
+	advanceTimelines(now);
+}
+
+void FD_TweenPool::schedule(std::shared_ptr<FD_TweenTimeline> timeline) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	if (timeline->scheduled) return;
+	timeline->scheduled = true;
+	timelines.push_back(timeline);
+}
+void FD_TweenPool::advanceTimelines(Uint32 now) {
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		if (timelines.empty()) return;
+		// Take the timelines, as callbacks may schedule more
+		scratch_timelines.clear();
+		for (auto& t : timelines) {
+			if (auto timeline = t.lock()) scratch_timelines.push_back(timeline);
+		}
+		timelines.clear();
+	}
+	for (auto& t : scratch_timelines) t->advance(now);
+	std::lock_guard<std::mutex> lock{ mutex };
+	// Keep those still playing, including any played again by a callback
+	for (auto& t : scratch_timelines) {
+		if (t->playing) {
+			timelines.push_back(t);
+		} else {
+			t->scheduled = false;
+		}
+	}
+	scratch_timelines.clear();
+}
+
+size_t FD_TweenPool::getActiveCount() const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	size_t count{ 0 };
+	for (size_t type = 0; type < type_count; type++) count += active[type].size();
+	return count;
+}
+size_t FD_TweenPool::getSize() const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	return size - free_slots.size();
+}
@@ -0,0 +1,216 @@
+#ifndef FD_TWEEN_POOL_H_
+#define FD_TWEEN_POOL_H_
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <SDL_stdinc.h>
+
+#include "fd_tween.hpp"
+#include "fd_easing.hpp"
+
+class FD_TweenTimeline;
+
+/*!
+	@file
+	@brief The file containing the FD_TweenPool class, the storage behind every FD_Tween.
+*/
+
+//! The class storing every tween as a structure of arrays.
+/*!
+	Each FD_Tween is a handle to a slot of the pool. Slots are stored in
+	blocks of arrays, one array per value, which are never moved once
+	allocated, so handles stay valid as the pool grows. Moving tweens are
+	listed by their type and, evaluated together by evaluate, once per
+	advance of the engine clock, which then advances the playing timelines. Tweens that are still are never evaluated, so
+	the cost of evaluation scales with the number of moving tweens and,
+	reading a value only loads it.
+
+	Tweens may be created, destroyed and, changed from several threads at
+	once, as long as each tween is only used by one of them, but evaluate must
+	not run alongside any of these.
+
+	\sa FD_Tween
+*/
+class FD_TweenPool {
+private:
+
+	static const Uint32 block_bits{ 10 };
+	static const Uint32 block_size{ 1 << block_bits };
+	static const Uint32 max_blocks{ 4096 };
+	static const size_t type_count{ FD_Easing::type_count };
+	// The type of a tween that is not moving
+	static const Uint8 still{ 0xFF };
+
+	struct Block {
+		Uint8 type[block_size];
+		Uint8 listed[block_size];
+		Uint8 force_moved[block_size];
+		Uint8 has_finished[block_size];
+		Uint32 start_time[block_size];
+		Uint32 duration[block_size];
+		Uint32 last_checked[block_size];
+		Uint32 changed_at[block_size];
+		double start_value[block_size];
+		double end_value[block_size];
+		double value[block_size];
+	};
+
+	std::unique_ptr<Block> blocks[max_blocks]{};
+	Uint32 size{ 0 };
+	std::vector<Uint32> free_slots{};
+	std::vector<Uint32> active[type_count]{};
+	mutable std::mutex mutex;
+
+	// The clock time the values were last evaluated at
+	std::atomic<Uint32> evaluated_at{ 0 };
+	std::atomic<bool> evaluated{ false };
+
+	// The timelines that are playing
+	std::vector<std::weak_ptr<FD_TweenTimeline>> timelines{};
+
+	// Scratch space for evaluation, reused every time
+	std::vector<Uint32> scratch_index{};
+	std::vector<double> scratch_progress{};
+	std::vector<std::shared_ptr<FD_TweenTimeline>> scratch_timelines{};
+
+	Block& block(Uint32 slot) const;
+	Uint32 getProgress(const Block& b, Uint32 i, Uint32 now) const;
+	double compute(const Block& b, Uint32 i, Uint32 now) const;
+	void list(Uint32 slot);
+
+	friend class FD_TweenTimeline;
+	void schedule(std::shared_ptr<FD_TweenTimeline> timeline);
+	void advanceTimelines(Uint32 now);
+
+	FD_TweenPool();
+
+public:
+
+	//! The slot held by no tween.
+	static const Uint32 none{ 0xFFFFFFFF };
+
+	//! Returns the pool used by every FD_Tween.
+	/*!
+		\return The pool.
+	*/
+	static FD_TweenPool& get();
+	//! Destroys the FD_TweenPool.
+	~FD_TweenPool();
+
+	//! Takes a free slot for a new tween.
+	/*!
+		\param value The starting value of the tween.
+
+		\return The slot.
+	*/
+	Uint32 allocate(double value);
+	//! Gives a slot back to the pool.
+	/*!
+		\param slot The slot, which may be none.
+	*/
+	void release(Uint32 slot);
+	//! Copies the state of one tween to another.
+	/*!
+		\param slot   The slot to copy to.
+		\param source The slot to copy from.
+	*/
+	void copy(Uint32 slot, Uint32 source);
+
+	//! Sets the value of a tween.
+	/*!
+		\param slot  The slot of the tween.
+		\param value The value to be set to.
+
+		\sa FD_Tween::set
+	*/
+	void set(Uint32 slot, double value);
+	//! Adds to the value of a tween.
+	/*!
+		\param slot  The slot of the tween.
+		\param value The value to be added.
+
+		\sa FD_Tween::add
+	*/
+	void add(Uint32 slot, double value);
+	//! Starts moving a tween.
+	/*!
+		\param slot        The slot of the tween.
+		\param type        The type of tween.
+		\param destination The end point of the tween.
+		\param duration    The length of time the tween will last in milliseconds.
+		\param pause       The length of time the tween will pause before initiating in milliseconds.
+
+		\sa FD_Tween::move
+	*/
+	void move(Uint32 slot, FD_TweenType type, double destination, Uint32 duration, Uint32 pause);
+
+	//! Returns the current value of a tween.
+	/*!
+		\param slot The slot of the tween.
+
+		\return The current value of the tween.
+	*/
+	double value(Uint32 slot) const;
+	//! Returns the destination of a tween.
+	/*!
+		\param slot The slot of the tween.
+
+		\return The destination of the tween.
+	*/
+	double destination(Uint32 slot) const;
+	//! Returns whether a tween has moved since it was last checked.
+	/*!
+		\param slot The slot of the tween.
+
+		\return Whether the tween has moved since it was last checked.
+	*/
+	bool moved(Uint32 slot);
+	//! Returns whether a tween has changed value since a given time, without counting as a check.
+	/*!
+		\param slot  The slot of the tween.
+		\param ticks The engine time to check from.
+
+		\return Whether the tween was set, added to or, moving at any point since the time.
+	*/
+	bool changedSince(Uint32 slot, Uint32 ticks) const;
+	//! Returns whether a tween has stopped moving.
+	/*!
+		\param slot The slot of the tween.
+
+		\return Whether the tween has stopped moving.
+	*/
+	bool done(Uint32 slot) const;
+	//! Returns whether a tween has finished since it was last checked.
+	/*!
+		\param slot The slot of the tween.
+
+		\return Whether the tween has finished since it was last checked.
+	*/
+	bool finished(Uint32 slot);
+
+	//! Evaluates every moving tween at the current engine time, then advances the playing timelines.
+	/*!
+		This is ran by FD_Looper after advancing the engine clock. Values read
+		before the tweens are evaluated at a new time are worked out on their own.
+
+		\sa FD_TweenTimeline
+	*/
+	void evaluate();
+
+	//! Returns the number of tweens listed for evaluation.
+	/*!
+		\return The number of tweens moving or waiting to, including any changed since the last evaluation.
+	*/
+	size_t getActiveCount() const;
+	//! Returns the number of tweens in the pool.
+	/*!
+		\return The number of tweens.
+	*/
+	size_t getSize() const;
+
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "fd_tweenTimeline.hpp"
+
+#include "fd_clock.hpp"
+#include "fd_tweenPool.hpp"
+#include "../main/fd_handling.hpp"
+
+FD_TweenTimeline::FD_TweenTimeline() {}
+FD_TweenTimeline::~FD_TweenTimeline() {}
+
+void FD_TweenTimeline::startStep(Uint32 now) {
+	Step& s{ steps[step] };
+	step_end = now + s.delay;
+	for (Entry& e : s.entries) {
+		// The step lasts until its longest action, pause included, has finished
+		Uint32 length{ e.action.pause + e.action.uses * e.action.pause_increment + e.action.duration };
+		if (static_cast<int>(now + length - step_end) > 0) step_end = now + length;
+		e.tween->apply(e.action);
+	}
+}
+void FD_TweenTimeline::advance(Uint32 now) {
+	// Steps without length finish together, but a looping timeline can't go round forever
+	size_t transitions{ 0 };
+	while (playing && static_cast<int>(now - step_end) >= 0 && transitions <= steps.size()) {
+		transitions++;
+		Uint32 current{ generation };
+		size_t finished{ step };
+		if (step_callback) step_callback(finished);
+		// Leave the timeline be if a callback played or stopped it
+		if (generation != current) continue;
+		if (finished + 1 >= steps.size()) {
+			if (!looping) playing = false;
+			if (completion_callback) completion_callback();
+			if (generation != current || !looping) continue;
+			step = 0;
+		} else {
+			step++;
+		}
+		startStep(now);
+	}
+}
+
+size_t FD_TweenTimeline::addStep() {
+	steps.emplace_back();
+	return steps.size() - 1;
+}
+void FD_TweenTimeline::add(FD_Tween* tween, FD_TweenAction action) {
+	if (tween == nullptr) {
+		FD_Handling::error("The given tween was nullptr.");
+		return;
+	}
+	if (steps.empty()) addStep();
+	steps.back().entries.push_back({ tween, action });
+}
+void FD_TweenTimeline::add(FD_Tween* tween, FD_TweenType type, double destination,
+	Uint32 duration, Uint32 pause) {
+	FD_TweenAction action{};
+	action.type = type;
+	action.destination = destination;
+	action.duration = duration;
+	action.pause = pause;
+	add(tween, action);
+}
+void FD_TweenTimeline::addDelay(Uint32 delay) {
+	if (steps.empty()) addStep();
+	if (delay > steps.back().delay) steps.back().delay = delay;
+}
+void FD_TweenTimeline::clear() {
+	stop();
+	steps.clear();
+}
+
+void FD_TweenTimeline::setStepCallback(std::function<void(size_t)> callback) {
+	this->step_callback = callback;
+}
+void FD_TweenTimeline::setCompletionCallback(std::function<void()> callback) {
+	this->completion_callback = callback;
+}
+void FD_TweenTimeline::setLooping(bool looping) {
+	this->looping = looping;
+}
+
+void FD_TweenTimeline::play() {
+	generation++;
+	step = 0;
+	playing = !steps.empty();
+	if (!playing) return;
+	std::shared_ptr<FD_TweenTimeline> self{ weak_from_this().lock() };
+	if (self == nullptr) {
+		FD_Handling::error("Timelines must be owned by a shared pointer to be played.");
+		playing = false;
+		return;
+	}
+	startStep(FD_Clock::getTicks());
+	FD_TweenPool::get().schedule(self);
+}
+void FD_TweenTimeline::stop() {
+	generation++;
+	playing = false;
+}
+
+bool FD_TweenTimeline::isPlaying() const { return playing; }
+size_t FD_TweenTimeline::getStep() const { return step; }
+size_t FD_TweenTimeline::getStepCount() const { return steps.size(); }
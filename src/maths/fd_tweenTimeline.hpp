@@ -0,0 +1,140 @@
+#ifndef FD_TWEEN_TIMELINE_H_
+#define FD_TWEEN_TIMELINE_H_
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include <SDL_stdinc.h>
+
+#include "fd_tween.hpp"
+
+/*!
+	@file
+	@brief The file containing the FD_TweenTimeline class, allowing tweens to be sequenced.
+*/
+
+//! The class that runs steps of tweens one after another, calling back as they finish.
+/*!
+	Each step is a group of tween actions started together. A step finishes
+	once its longest action (including its pause) has, at which point the
+	next step starts. Timelines are advanced by FD_TweenPool::evaluate, so
+	nothing needs to check whether tweens have finished and, a timeline that
+	isn't playing costs nothing.
+
+	The tweens given must outlive the timeline whilst it plays, so a timeline
+	is usually owned by whatever owns its tweens. Callbacks are ran on the
+	thread evaluating the tweens, before the next update.
+
+	\sa FD_TweenPool
+*/
+class FD_TweenTimeline : public std::enable_shared_from_this<FD_TweenTimeline> {
+private:
+
+	friend class FD_TweenPool;
+
+	struct Entry {
+		FD_Tween* tween;
+		FD_TweenAction action;
+	};
+	struct Step {
+		std::vector<Entry> entries{};
+		Uint32 delay{ 0 };
+	};
+
+	std::vector<Step> steps{};
+	std::function<void(size_t)> step_callback{};
+	std::function<void()> completion_callback{};
+	bool looping{ false };
+
+	bool playing{ false };
+	// Whether the pool holds the timeline, guarded by the pool
+	bool scheduled{ false };
+	// Incremented whenever the timeline is played or stopped
+	Uint32 generation{ 0 };
+	size_t step{ 0 };
+	Uint32 step_end{ 0 };
+
+	void startStep(Uint32 now);
+	void advance(Uint32 now);
+
+public:
+
+	//! Constructs a FD_TweenTimeline.
+	FD_TweenTimeline();
+	//! Destroys the FD_TweenTimeline.
+	~FD_TweenTimeline();
+
+	//! Adds a new, empty step after the others.
+	/*!
+		\return The index of the step.
+	*/
+	size_t addStep();
+	//! Adds a tween action to the last step, adding a step if there are none.
+	/*!
+		\param tween  The tween to move.
+		\param action The action to apply to the tween.
+	*/
+	void add(FD_Tween* tween, FD_TweenAction action);
+	//! Adds a tween movement to the last step, adding a step if there are none.
+	/*!
+		\param tween       The tween to move.
+		\param type        The type of tween.
+		\param destination The end point of the tween.
+		\param duration    The length of time the tween will last in milliseconds.
+		\param pause       The length of time the tween will pause before initiating in milliseconds.
+	*/
+	void add(FD_Tween* tween, FD_TweenType type, double destination, Uint32 duration, Uint32 pause = 0);
+	//! Makes the last step last at least a given time, adding a step if there are none.
+	/*!
+		\param delay The minimum length of the step in milliseconds.
+	*/
+	void addDelay(Uint32 delay);
+	//! Removes every step, stopping the timeline.
+	void clear();
+
+	//! Sets the function called as each step finishes.
+	/*!
+		\param callback The function, given the index of the step that finished.
+	*/
+	void setStepCallback(std::function<void(size_t)> callback);
+	//! Sets the function called as the last step finishes.
+	/*!
+		\param callback The function.
+	*/
+	void setCompletionCallback(std::function<void()> callback);
+	//! Sets whether the timeline starts again after the last step finishes.
+	/*!
+		The completion callback is still called each time the last step finishes.
+
+		\param looping Whether the timeline loops.
+	*/
+	void setLooping(bool looping);
+
+	//! Starts the timeline from the first step.
+	/*!
+		\warning The timeline must be owned by a std::shared_ptr.
+	*/
+	void play();
+	//! Stops the timeline, leaving its tweens where they are.
+	void stop();
+
+	//! Returns whether the timeline is playing.
+	/*!
+		\return Whether the timeline is playing.
+	*/
+	bool isPlaying() const;
+	//! Returns the index of the step being played.
+	/*!
+		\return The index of the current step.
+	*/
+	size_t getStep() const;
+	//! Returns the number of steps.
+	/*!
+		\return The number of steps.
+	*/
+	size_t getStepCount() const;
+
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "fd_animation.hpp"
+
+#include <algorithm>
+
+#include "../maths/fd_clock.hpp"
+
+// Animation Clip Member Functions
+
+FD_AnimationClip::FD_AnimationClip(std::vector<FD_AnimationFrame> frames) : frames{ frames } {
+	if (this->frames.empty()) this->frames.push_back(FD_AnimationFrame());
+	ends.reserve(this->frames.size());
+	for (FD_AnimationFrame& f : this->frames) {
+		if (f.duration == 0) f.duration = 1;
+		duration += f.duration;
+		ends.push_back(duration);
+	}
+}
+FD_AnimationClip::~FD_AnimationClip() {}
+
+std::shared_ptr<const FD_AnimationClip> FD_AnimationClip::fromGrid(int frame_width,
+	int frame_height, int columns, int count, Uint32 duration, int first, int spacing) {
+	if (columns < 1) columns = 1;
+	std::vector<FD_AnimationFrame> frames{};
+	for (int i = first; i < first + count; i++) {
+		FD_AnimationFrame f{};
+		f.srcrect = { (i % columns) * (frame_width + spacing),
+			(i / columns) * (frame_height + spacing), frame_width, frame_height };
+		f.duration = duration;
+		frames.push_back(f);
+	}
+	return std::make_shared<const FD_AnimationClip>(frames);
+}
+
+size_t FD_AnimationClip::getFrameCount() const { return frames.size(); }
+const FD_AnimationFrame& FD_AnimationClip::getFrame(size_t index) const {
+	return frames.at(index);
+}
+Uint32 FD_AnimationClip::getDuration() const { return duration; }
+size_t FD_AnimationClip::getFrameAt(Uint32 time) const {
+	if (time >= duration) return frames.size() - 1;
+	return static_cast<size_t>(std::upper_bound(ends.begin(), ends.end(), time) - ends.begin());
+}
+
+// Animator Member Functions
+
+FD_Animator::FD_Animator() {}
+FD_Animator::~FD_Animator() {}
+
+// Counts the frames shown from the start, so every frame passed can be found
+Uint64 FD_Animator::sequenceAt(Uint64 time) {
+	Uint64 n{ clip->getFrameCount() };
+	Uint64 length{ clip->getDuration() };
+	if (mode == FD_ANIMATION_ONCE) {
+		if (time < length) return clip->getFrameAt(static_cast<Uint32>(time));
+		finished = true;
+		return n - 1;
+	}
+	if (mode == FD_ANIMATION_PING_PONG && n > 1) {
+		// The second half plays the time backwards
+		Uint64 cycle{ (time / (2 * length)) * 2 * n };
+		Uint64 within{ time % (2 * length) };
+		if (within < length) return cycle + clip->getFrameAt(static_cast<Uint32>(within));
+		return cycle + 2 * n - 1 - clip->getFrameAt(static_cast<Uint32>(2 * length - 1 - within));
+	}
+	return (time / length) * n + clip->getFrameAt(static_cast<Uint32>(time % length));
+}
+size_t FD_Animator::frameOf(Uint64 sequence) const {
+	Uint64 n{ clip->getFrameCount() };
+	if (mode == FD_ANIMATION_ONCE) return static_cast<size_t>(sequence < n ? sequence : n - 1);
+	if (mode == FD_ANIMATION_PING_PONG && n > 1) {
+		Uint64 r{ sequence % (2 * n) };
+		return static_cast<size_t>(r < n ? r : 2 * n - 1 - r);
+	}
+	return static_cast<size_t>(sequence % n);
+}
+
+void FD_Animator::play(std::shared_ptr<const FD_AnimationClip> clip,
+	FD_AnimationMode mode, double rate) {
+	this->clip = clip;
+	this->mode = mode;
+	setRate(rate);
+	position = 0;
+	last_ticks = FD_Clock::getTicks();
+	playing = clip != nullptr;
+	finished = false;
+	started = false;
+	sequence = 0;
+	frame = 0;
+}
+void FD_Animator::stop() {
+	playing = false;
+}
+void FD_Animator::resume() {
+	if (clip == nullptr || playing) return;
+	last_ticks = FD_Clock::getTicks();
+	playing = true;
+}
+bool FD_Animator::update(Uint32 ticks) {
+	if (!playing || clip == nullptr) {
+		last_ticks = ticks;
+		return false;
+	}
+	bool changed{ !started };
+	if (!started) {
+		// The first frame is shown as soon as the clip is played
+		started = true;
+		int event{ clip->getFrame(0).event };
+		if (event != 0 && listener) events.push_back(event);
+	}
+	if (finished) return changed;
+	position += (ticks - last_ticks) * rate;
+	last_ticks = ticks;
+	Uint64 next{ sequenceAt(static_cast<Uint64>(position)) };
+	if (next == sequence) return changed;
+	if (listener) {
+		// Give the events of the frames passed, at most a playthrough's worth
+		Uint64 limit{ 2 * static_cast<Uint64>(clip->getFrameCount()) };
+		Uint64 s{ next - sequence > limit ? next - limit : sequence };
+		while (s < next) {
+			int event{ clip->getFrame(frameOf(++s)).event };
+			if (event != 0) events.push_back(event);
+		}
+	}
+	sequence = next;
+	size_t shown{ frameOf(next) };
+	changed = changed || shown != frame;
+	frame = shown;
+	return changed;
+}
+
+void FD_Animator::deliverEvents() {
+	// The listener may play another clip, so give it the events from aside
+	delivering.swap(events);
+	for (int event : delivering) {
+		if (listener) listener(event);
+	}
+	delivering.clear();
+}
+
+void FD_Animator::setRate(double rate) {
+	this->rate = rate < 0 ? 0 : rate;
+}
+void FD_Animator::setListener(std::function<void(int)> listener) {
+	this->listener = listener;
+}
+
+std::shared_ptr<const FD_AnimationClip> FD_Animator::getClip() const { return clip; }
+size_t FD_Animator::getFrame() const { return frame; }
+const SDL_Rect& FD_Animator::getSourceRect() const {
+	return clip->getFrame(frame).srcrect;
+}
+bool FD_Animator::isPlaying() const { return playing; }
+bool FD_Animator::hasEvents() const { return !events.empty(); }
+bool FD_Animator::isFinished() const { return finished; }
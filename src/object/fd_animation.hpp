@@ -0,0 +1,225 @@
+#ifndef FD_ANIMATION_H_
+#define FD_ANIMATION_H_
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include <SDL_rect.h>
+#include <SDL_stdinc.h>
+
+/*!
+	@file
+	@brief The file containing the FD_AnimationClip and FD_Animator classes for sprite-sheet animation.
+*/
+
+//! The structure containing a single frame of an animation.
+struct FD_AnimationFrame {
+	//! The source rectangle of the frame, relative to the image.
+	SDL_Rect srcrect{ 0, 0, 0, 0 };
+	//! How long the frame is shown, in milliseconds.
+	Uint32 duration{ 100 };
+	//! The event given to the animator's listener when the frame is shown, or zero for none.
+	int event{ 0 };
+};
+
+//! The enumeration containing the ways an animation can play.
+enum FD_AnimationMode {
+	//! Plays the frames once, stopping on the last.
+	FD_ANIMATION_ONCE,
+	//! Plays the frames from the first to the last, repeatedly.
+	FD_ANIMATION_LOOP,
+	//! Plays the frames forwards then backwards, repeatedly.
+	FD_ANIMATION_PING_PONG
+};
+
+//! The class containing the frames of an animation.
+/*!
+	A clip never changes once made, so one clip can be shared by any number of
+	animators, on any thread, without being copied.
+
+	\sa FD_Animator
+*/
+class FD_AnimationClip {
+private:
+
+	std::vector<FD_AnimationFrame> frames;
+	std::vector<Uint32> ends{};
+	Uint32 duration{ 0 };
+
+public:
+
+	//! Constructs a FD_AnimationClip.
+	/*!
+		Frames shorter than a millisecond are shown for one.
+
+		\param frames The frames of the animation, in order.
+	*/
+	FD_AnimationClip(std::vector<FD_AnimationFrame> frames);
+	//! Destroys the FD_AnimationClip.
+	~FD_AnimationClip();
+
+	//! Makes a clip from frames laid out in a grid on a sprite sheet.
+	/*!
+		The frames are taken left to right, then top to bottom. The sheet may be
+		an image of its own or, part of an atlas, as source rectangles are
+		relative to the image.
+
+		\param frame_width  The width of each frame.
+		\param frame_height The height of each frame.
+		\param columns      The number of frames in each row of the sheet.
+		\param count        The number of frames in the clip.
+		\param duration     How long each frame is shown, in milliseconds.
+		\param first        The position of the first frame on the sheet.
+		\param spacing      The space between neighbouring frames on the sheet.
+
+		\return The clip.
+	*/
+	static std::shared_ptr<const FD_AnimationClip> fromGrid(int frame_width, int frame_height,
+		int columns, int count, Uint32 duration, int first = 0, int spacing = 0);
+
+	//! Returns the number of frames.
+	/*!
+		\return The number of frames.
+	*/
+	size_t getFrameCount() const;
+	//! Returns a specific frame.
+	/*!
+		\param index The index of the frame.
+
+		\return The frame.
+	*/
+	const FD_AnimationFrame& getFrame(size_t index) const;
+	//! Returns the time taken to show every frame once.
+	/*!
+		\return The duration of the clip in milliseconds.
+	*/
+	Uint32 getDuration() const;
+	//! Returns the frame shown a given time into the clip.
+	/*!
+		\param time The time into the clip in milliseconds, kept within the duration.
+
+		\return The index of the frame.
+	*/
+	size_t getFrameAt(Uint32 time) const;
+
+};
+
+//! The class that plays an animation clip against the engine clock.
+/*!
+	The animator only holds a reference to its clip and its place in it, so
+	playing costs no allocation. It is advanced by FD_Element as its object
+	group updates, which may be on a job system thread, so the events of the
+	frames shown are held until deliverEvents. The object group delivers them
+	once all of its objects have updated, one object at a time.
+
+	\sa FD_Element::play
+*/
+class FD_Animator {
+private:
+
+	std::shared_ptr<const FD_AnimationClip> clip{ nullptr };
+	FD_AnimationMode mode{ FD_ANIMATION_LOOP };
+	double rate{ 1 };
+	double position{ 0 };
+	Uint32 last_ticks{ 0 };
+	bool playing{ false };
+	bool finished{ false };
+	bool started{ false };
+	Uint64 sequence{ 0 };
+	size_t frame{ 0 };
+
+	std::function<void(int)> listener{ nullptr };
+	std::vector<int> events{};
+	std::vector<int> delivering{};
+
+	Uint64 sequenceAt(Uint64 time);
+	size_t frameOf(Uint64 sequence) const;
+
+public:
+
+	//! Constructs a FD_Animator.
+	FD_Animator();
+	//! Destroys the FD_Animator.
+	~FD_Animator();
+
+	//! Starts playing a clip from its first frame.
+	/*!
+		\param clip The clip to play.
+		\param mode How the clip is played.
+		\param rate The speed the clip is played at, where 1 is as the clip's durations give.
+	*/
+	void play(std::shared_ptr<const FD_AnimationClip> clip,
+		FD_AnimationMode mode = FD_ANIMATION_LOOP, double rate = 1);
+	//! Stops playing, leaving the current frame shown.
+	void stop();
+	//! Continues playing from the current frame after stop.
+	void resume();
+	//! Moves the animation on to the engine time given.
+	/*!
+		The event of every frame shown since the last update, up to a full
+		playthrough's worth, is held for deliverEvents.
+
+		\param ticks The engine time.
+
+		\return Whether a different frame should be shown.
+
+		\sa FD_Clock::getTicks
+	*/
+	bool update(Uint32 ticks);
+	//! Gives the listener the events held by update, in the order they were shown.
+	/*!
+		\sa hasEvents
+	*/
+	void deliverEvents();
+
+	//! Sets the speed of playback.
+	/*!
+		\param rate The speed the clip is played at, where 1 is as the clip's durations give, no less than zero.
+	*/
+	void setRate(double rate);
+	//! Sets the function given the events of frames as they are shown.
+	/*!
+		The listener is called by deliverEvents, which the object group does
+		after its objects update, so it isn't ran on job system threads.
+
+		\param listener The function given the events, or nullptr for none.
+	*/
+	void setListener(std::function<void(int)> listener);
+
+	//! Returns the clip being played.
+	/*!
+		\return The clip being played, or nullptr if there is none.
+	*/
+	std::shared_ptr<const FD_AnimationClip> getClip() const;
+	//! Returns the index of the frame being shown.
+	/*!
+		\return The index of the frame.
+	*/
+	size_t getFrame() const;
+	//! Returns the source rectangle of the frame being shown.
+	/*!
+		\return The source rectangle of the frame.
+
+		\warning The animator must have a clip.
+	*/
+	const SDL_Rect& getSourceRect() const;
+	//! Returns whether the animator is playing.
+	/*!
+		\return Whether the animator is playing.
+	*/
+	bool isPlaying() const;
+	//! Returns whether there are events waiting for deliverEvents.
+	/*!
+		\return Whether there are events waiting.
+	*/
+	bool hasEvents() const;
+	//! Returns whether a clip played once has reached its last frame.
+	/*!
+		\return Whether the clip has finished.
+	*/
+	bool isFinished() const;
+
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "fd_element.hpp"
 
 #include "../display/fd_scene.hpp"
+#include "../maths/fd_clock.hpp"
 
 FD_Element::FD_Element(std::weak_ptr<FD_Image> image, double x,
 	double y, double angle, int z, double scale, double scale_y,
@@ -8,27 +9,49 @@ FD_Element::FD_Element(std::weak_ptr<FD_Image> image, double x,
 	: FD_Object(z, camera_bound, x, y, 0, 0, angle) {
 	// Set image
 	this->setImage(image);
-	this->scale_w->set(scale);
-	this->scale_h->set((scale_y < 0) ? scale : scale_y);
+	this->scale_w.set(scale);
+	this->scale_h.set((scale_y < 0) ? scale : scale_y);
 	// Set draw style
 	draw_style = style;
 	// Create the bounds
-	this->dstrect = new SDL_Rect();
+	this->dstrect = &owned_dstrect;
 	this->updateBounds();
 }
 FD_Element::~FD_Element() {}
 
 void FD_Element::update() {
-	if (x->moved() || y->moved() || angle->moved()
-		|| scale_w->moved() || scale_h->moved()) {
+	if (x.moved() || y.moved() || angle.moved()
+		|| scale_w.moved() || scale_h.moved()) {
 		updateBounds();
 	}
 }
 
+void FD_Element::tick() {
+	Uint32 ticks{ FD_Clock::getTicks() };
+	if (animator.update(ticks)) {
+		showFrame();
+		frame_shown_at = ticks;
+	}
+	FD_Object::tick();
+}
+bool FD_Element::hasChangedSince(Uint32 ticks) const {
+	return static_cast<int>(frame_shown_at - ticks) >= 0 || FD_Object::hasChangedSince(ticks);
+}
+bool FD_Element::hasEvents() const { return animator.hasEvents(); }
+void FD_Element::deliverEvents() { animator.deliverEvents(); }
+
+void FD_Element::showFrame() {
+	const SDL_Rect& frame{ animator.getSourceRect() };
+	bool resized{ srcrect == nullptr || srcrect->w != frame.w || srcrect->h != frame.h };
+	owned_srcrect = frame;
+	srcrect = &owned_srcrect;
+	if (resized) updateBounds();
+}
+
 void FD_Element::updateBounds() {
 	if (dstrect != nullptr) {
-		FD_Object::updateBounds(dstrect, x->value(),
-			y->value(), getWidth(),
+		FD_Object::updateBounds(dstrect, x.value(),
+			y.value(), getWidth(),
 			getHeight(), draw_style);
 	}
 }
@@ -49,36 +72,39 @@ void FD_Element::setUnderlayColour(SDL_Colour colour) {
 void FD_Element::setImage(std::weak_ptr<FD_Image> image) {
 	this->image = image;
 	if (auto i = image.lock()) {
-		w->set(i->getWidth());
-		h->set(i->getHeight());
+		w.set(i->getWidth());
+		h.set(i->getHeight());
 	} else {
-		w->set(0);
-		h->set(0);
+		w.set(0);
+		h.set(0);
 	}
 	updateBounds();
 }
 void FD_Element::setSourceRect(SDL_Rect rect) {
-	if (srcrect == nullptr) srcrect = new SDL_Rect();
+	if (srcrect == nullptr) srcrect = &owned_srcrect;
 	srcrect->x = rect.x;
 	srcrect->y = rect.y;
 	srcrect->w = rect.w;
 	srcrect->h = rect.h;
 	FD_Element::updateBounds();
 }
+void FD_Element::play(std::shared_ptr<const FD_AnimationClip> clip,
+	FD_AnimationMode mode, double rate) {
+	animator.play(clip, mode, rate);
+	if (animator.update(FD_Clock::getTicks())) showFrame();
+}
+FD_Animator* FD_Element::getAnimator() { return &animator; }
 void FD_Element::removeSourceRect() {
-	if (srcrect != nullptr) {
-		delete srcrect;
-		srcrect = nullptr;
-	}
+	srcrect = nullptr;
 }
 void FD_Element::setWidth(int width) {
 	if (auto image = this->image.lock()) {
-		scale_w->set(width / static_cast<double>(image->getWidth()));
+		scale_w.set(width / static_cast<double>(image->getWidth()));
 	}
 }
 void FD_Element::setHeight(int height) {
 	if (auto image = this->image.lock()) {
-		scale_h->set(height / static_cast<double>(image->getHeight()));
+		scale_h.set(height / static_cast<double>(image->getHeight()));
 	}
 }
 void FD_Element::setFlipFlags(SDL_RendererFlip f) { flip_flags = f; }
@@ -94,32 +120,32 @@ std::shared_ptr<FD_Image> FD_Element::getImage() const {
 double FD_Element::getWidth() const {
 	if (srcrect == nullptr) {
 		if (auto image = this->image.lock()) {
-			return static_cast<int>(image->getWidth() * scale_w->value());
+			return static_cast<int>(image->getWidth() * scale_w.value());
 		} else {
 			return 0;
 		}
 	}
-	return static_cast<int>(srcrect->w * scale_w->value());
+	return static_cast<int>(srcrect->w * scale_w.value());
 }
 double FD_Element::getHeight() const {
 	if (srcrect == nullptr) {
 		if (auto image = this->image.lock()) {
-			return static_cast<int>(image->getHeight() * scale_h->value());
+			return static_cast<int>(image->getHeight() * scale_h.value());
 		} else {
 			return 0;
 		}
 	}
-	return static_cast<int>(srcrect->h * scale_h->value());
+	return static_cast<int>(srcrect->h * scale_h.value());
 }
 
-FD_Tween* FD_Element::getTweenX() { return x; }
-FD_Tween* FD_Element::getTweenY() { return y; }
-FD_Tween* FD_Element::getTweenAngle() { return angle; }
-FD_Tween* FD_Element::getTweenScaleX() { return scale_w; }
-FD_Tween* FD_Element::getTweenScaleY() { return scale_h; }
-FD_Tween* FD_Element::getTweenOpacity() { return opacity; }
-FD_Tween* FD_Element::getTweenCenterX() { return center_x; }
-FD_Tween* FD_Element::getTweenCenterY() { return center_y; }
+FD_Tween* FD_Element::getTweenX() { return &x; }
+FD_Tween* FD_Element::getTweenY() { return &y; }
+FD_Tween* FD_Element::getTweenAngle() { return &angle; }
+FD_Tween* FD_Element::getTweenScaleX() { return &scale_w; }
+FD_Tween* FD_Element::getTweenScaleY() { return &scale_h; }
+FD_Tween* FD_Element::getTweenOpacity() { return &opacity; }
+FD_Tween* FD_Element::getTweenCenterX() { return &center_x; }
+FD_Tween* FD_Element::getTweenCenterY() { return &center_y; }
 
 void FD_Element::assimilate(std::shared_ptr<FD_ObjectGroup> group) {
 	group->addObject(shared_from_this());
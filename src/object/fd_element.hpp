@@ -2,6 +2,7 @@
 #define FD_ELEMENT_H_
 
 #include "fd_object.hpp"
+#include "fd_animation.hpp"
 #include "../maths/fd_tween.hpp"
 #include "../input/fd_imageManager.hpp"
 
@@ -15,8 +16,11 @@ class FD_Element : public FD_Object, public std::enable_shared_from_this<FD_Elem
 private:
 
 	std::weak_ptr<FD_Image> image;
+	FD_Animator animator{};
+	Uint32 frame_shown_at{ 0 };
 
 	void updateBounds();
+	void showFrame();
 
 public:
 	
@@ -44,6 +48,22 @@ public:
 
 	//! Updates the element.
 	void update();
+	//! Moves any animation on to the engine time and, records the element for interpolation.
+	void tick() override;
+	//! Returns whether the tweens or, the frame of the element have changed since a given time.
+	/*!
+		\param ticks The engine time to check from.
+
+		\return Whether the element may be drawn differently since the time.
+	*/
+	bool hasChangedSince(Uint32 ticks) const override;
+	//! Returns whether the animation has frame events waiting.
+	/*!
+		\return Whether the animation has frame events waiting.
+	*/
+	bool hasEvents() const override;
+	//! Gives the animation's listener the events of the frames shown as it ticked.
+	void deliverEvents() override;
 
 	//! Returns the image.
 	/*!
@@ -125,6 +145,25 @@ public:
 	*/
 	void setFlipFlags(SDL_RendererFlip f);
 
+	//! Plays an animation, showing its first frame straight away.
+	/*!
+		Each frame sets the source rectangle as the element's group updates.
+		The bounds are only updated when the size of the frame changes.
+
+		\param clip The clip to play, which may be shared with other elements.
+		\param mode How the clip is played.
+		\param rate The speed the clip is played at, where 1 is as the clip's durations give.
+
+		\sa FD_AnimationClip
+	*/
+	void play(std::shared_ptr<const FD_AnimationClip> clip,
+		FD_AnimationMode mode = FD_ANIMATION_LOOP, double rate = 1);
+	//! Returns the animator of the element.
+	/*!
+		\return The animator of the element.
+	*/
+	FD_Animator* getAnimator();
+
 	//! Removes the given source rectangle.
 	/*!
 		\sa setSourceRect
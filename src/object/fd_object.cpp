@@ -1,63 +1,99 @@
 #include "fd_object.hpp"
 
+#include <cstdlib>
+#include <algorithm>
+
 // FD_Object Member Functions
 
 FD_Object::FD_Object(int z, bool camera_bound, double x, double y, double w, double h,
 	double angle, double scale_w, double scale_h, Uint8 opacity, bool visible)
-	: FD_Layered(z, camera_bound) {
-	this->x = new FD_Tween(x);
-	this->y = new FD_Tween(y);
-	this->w = new FD_Tween(w);
-	this->h = new FD_Tween(h);
-	this->angle = new FD_Tween(angle);
-	this->scale_w = new FD_Tween(scale_w);
-	this->scale_h = new FD_Tween(scale_h);
-	this->opacity = new FD_Tween(opacity);
-	this->center_x = new FD_Tween(0.5);
-	this->center_y = new FD_Tween(0.5);
+	: FD_Layered(z, camera_bound), x{ x }, y{ y }, w{ w }, h{ h }, angle{ angle },
+	scale_w{ scale_w }, scale_h{ scale_h }, opacity{ static_cast<double>(opacity) } {
 	this->visible = visible;
 }
-FD_Object::~FD_Object() {
-	delete x;
-	delete y;
-	delete w;
-	delete h;
-	delete angle;
-	delete scale_w;
-	delete scale_h;
-	delete opacity;
-	delete center_x;
-	delete center_y;
-	if (srcrect != nullptr) delete srcrect;
-	if (dstrect != nullptr) delete dstrect;
-}
-
-void FD_Object::render(SDL_Renderer* renderer, const Uint8 alpha,
-	const std::shared_ptr<const FD_Camera> camera) const {
-	std::shared_ptr<FD_Image> image{ getImage() };
+FD_Object::~FD_Object() {}
+
+bool FD_Object::getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+	const std::shared_ptr<const FD_Camera> camera, const double interpolation) const {
 	Uint8 opacity{ getOpacity() };
 	if (alpha == 0) {
 		opacity = 0;
 	} else if (alpha != 255) {
 		opacity = static_cast<Uint8>((alpha / 255.0) * opacity);
 	}
+	if (opacity == 0) return false;
 	SDL_Rect dr{ };
 	dr.x = getDestinationRect()->x;
 	dr.y = getDestinationRect()->y;
 	dr.w = getDestinationRect()->w;
 	dr.h = getDestinationRect()->h;
+	if (interpolated && ticked) {
+		// Blend from the previous update to the last, ignoring changes made since
+		double i{ interpolation };
+		if (i < 0) i = 0;
+		if (i > 1) i = 1;
+		const SDL_Rect& from{ previous_dstrect };
+		const SDL_Rect& to{ ticked_dstrect };
+		dr.x = static_cast<int>(from.x + (to.x - from.x) * i);
+		dr.y = static_cast<int>(from.y + (to.y - from.y) * i);
+		dr.w = static_cast<int>(from.w + (to.w - from.w) * i);
+		dr.h = static_cast<int>(from.h + (to.h - from.h) * i);
+	}
 	double angle{ getAngle() };
-	if (this->isCameraBound()) {
-		if (!camera->manipulate(dr, angle)) return;
+	if (this->isCameraBound() && camera != nullptr) {
+		if (!camera->manipulate(dr, angle)) return false;
 	}
-	image->render(renderer, opacity, getSourceRect(), &dr,
-		angle, getCenterX(), getCenterY(), getFlipFlags(), 
-		getBlendMode(), getClipRect());
+	command.type = FD_DRAW_IMAGE;
+	command.layer = getLayer();
+	command.image = getImage();
+	command.texture = command.image == nullptr ? nullptr : command.image->getTexture();
+	command.alpha = opacity;
+	const SDL_Rect* src{ getSourceRect() };
+	command.has_srcrect = src != nullptr;
+	if (command.has_srcrect) command.srcrect = *src;
+	command.dstrect = dr;
+	command.angle = angle;
+	command.center_x = getCenterX();
+	command.center_y = getCenterY();
+	command.flip = getFlipFlags();
+	command.blend = getBlendMode();
+	const SDL_Rect* clip{ getClipRect() };
+	command.has_clip = clip != nullptr;
+	if (command.has_clip) command.clip = *clip;
+	return true;
+}
+
+bool FD_Object::getCullingBounds(SDL_Rect& bounds) const {
+	const SDL_Rect* rect{ getDestinationRect() };
+	if (!isCameraBound() || rect == nullptr) return false;
+	bounds = *rect;
+	if (interpolated && ticked) SDL_UnionRect(&previous_dstrect, &ticked_dstrect, &bounds);
+	return true;
+}
+
+bool FD_Object::hasChangedSince(Uint32 ticks) const {
+	return x.changedSince(ticks) || y.changedSince(ticks) || w.changedSince(ticks)
+		|| h.changedSince(ticks) || angle.changedSince(ticks) || scale_w.changedSince(ticks)
+		|| scale_h.changedSince(ticks) || opacity.changedSince(ticks)
+		|| center_x.changedSince(ticks) || center_y.changedSince(ticks);
 }
 
+void FD_Object::tick() {
+	const SDL_Rect* rect{ getDestinationRect() };
+	if (rect == nullptr) return;
+	previous_dstrect = ticked ? ticked_dstrect : *rect;
+	ticked_dstrect = *rect;
+	ticked = true;
+}
+
+void FD_Object::setInterpolated(bool interpolated) {
+	this->interpolated = interpolated;
+}
+bool FD_Object::isInterpolated() const { return interpolated; }
+
 void FD_Object::updateBounds(SDL_Rect* rect) {
-	this->updateBounds(rect, this->x->value(), this->y->value(),
-		this->w->value(), this->h->value(), draw_style);
+	this->updateBounds(rect, this->x.value(), this->y.value(),
+		this->w.value(), this->h.value(), draw_style);
 }
 void FD_Object::updateBounds(SDL_Rect* rect, double x, double y,
 	double w, double h, FD_DrawStyle style) {
@@ -91,25 +127,25 @@ void FD_Object::updateBounds(SDL_Rect* rect, double x, double y,
 	}
 }
 
-double FD_Object::getX() const { return x->value(); }
-double FD_Object::getY() const { return y->value(); }
+double FD_Object::getX() const { return x.value(); }
+double FD_Object::getY() const { return y.value(); }
 double FD_Object::getWidth() const {
-	double v = w->value();
+	double v = w.value();
 	if (v < 0) return 0;
 	return v;
 }
 double FD_Object::getHeight() const {
-	double v = h->value();
+	double v = h.value();
 	if (v < 0) return 0;
 	return v;
 }
 double FD_Object::getWidthScale() const {
-	double v = scale_w->value();
+	double v = scale_w.value();
 	if (v < 0) return 0;
 	return v;
 }
 double FD_Object::getHeightScale() const {
-	double v = scale_h->value();
+	double v = scale_h.value();
 	if (v < 0) return 0;
 	return v;
 }
@@ -117,14 +153,14 @@ bool FD_Object::isVisible() const { return visible; }
 
 SDL_Rect* FD_Object::getSourceRect() const { return srcrect; }
 SDL_Rect* FD_Object::getDestinationRect() const { return dstrect; }
-double FD_Object::getAngle() const { return angle->value(); }
-double FD_Object::getCenterX() const { return center_x->value(); };
-double FD_Object::getCenterY() const { return center_y->value(); };
+double FD_Object::getAngle() const { return angle.value(); }
+double FD_Object::getCenterX() const { return center_x.value(); };
+double FD_Object::getCenterY() const { return center_y.value(); };
 SDL_RendererFlip FD_Object::getFlipFlags() const { return flip_flags; }
 SDL_BlendMode FD_Object::getBlendMode() const { return blend_mode;  }
 SDL_Rect* FD_Object::getClipRect() const { return clip_rect; }
 Uint8 FD_Object::getOpacity() const {
-	double v = opacity->value();
+	double v = opacity.value();
 	if (v > 255) return 255;
 	if (v < 0) return 0;
 	return static_cast<Uint8>(v);
@@ -133,21 +169,11 @@ Uint8 FD_Object::getOpacity() const {
 // FD_Line Member Functions
 
 FD_Line::FD_Line(double x1, double y1, double x2, double y2, int z,
-	bool camera_bound, SDL_Colour colour) : FD_Layered(z, camera_bound) {
+	bool camera_bound, SDL_Colour colour) : FD_Layered(z, camera_bound),
+	x1{ x1 }, y1{ y1 }, x2{ x2 }, y2{ y2 } {
 	this->colour = colour;
-	this->x1 = new FD_Tween(x1);
-	this->y1 = new FD_Tween(y1);
-	this->x2 = new FD_Tween(x2);
-	this->y2 = new FD_Tween(y2);
-	this->opacity = new FD_Tween(255);
-}
-FD_Line::~FD_Line() {
-	delete x1;
-	delete y1;
-	delete x2;
-	delete y2;
-	delete opacity;
 }
+FD_Line::~FD_Line() {}
 
 void FD_Line::removePoints() {
 	p1 = nullptr;
@@ -165,25 +191,46 @@ void FD_Line::removeClipRect() {
 	this->clip_rect = nullptr;
 }
 
-void FD_Line::render(SDL_Renderer* renderer, const Uint8 alpha,
-	const std::shared_ptr<const FD_Camera> camera) const {
-	if (alpha == 0 || !visible) return;
-	SDL_BlendMode old_blend{ };
-	SDL_GetRenderDrawBlendMode(renderer, &old_blend);
-	SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+bool FD_Line::getCullingBounds(SDL_Rect& bounds) const {
+	if (!isCameraBound()) return false;
+	if (p1 == nullptr || p2 == nullptr) {
+		// Cover where the tweens are and, where they are going
+		double xs[]{ x1.value(), x2.value(), x1.destination(), x2.destination() };
+		double ys[]{ y1.value(), y2.value(), y1.destination(), y2.destination() };
+		double min_x{ xs[0] }, max_x{ xs[0] }, min_y{ ys[0] }, max_y{ ys[0] };
+		for (int i = 1; i < 4; i++) {
+			min_x = std::min(min_x, xs[i]);
+			max_x = std::max(max_x, xs[i]);
+			min_y = std::min(min_y, ys[i]);
+			max_y = std::max(max_y, ys[i]);
+		}
+		bounds = { static_cast<int>(min_x), static_cast<int>(min_y),
+			static_cast<int>(max_x - min_x) + 1, static_cast<int>(max_y - min_y) + 1 };
+	} else {
+		bounds = { std::min(p1->x, p2->x), std::min(p1->y, p2->y),
+			std::abs(p1->x - p2->x) + 1, std::abs(p1->y - p2->y) + 1 };
+	}
+	return true;
+}
+bool FD_Line::hasChangedSince(Uint32 ticks) const {
+	return x1.changedSince(ticks) || y1.changedSince(ticks) || x2.changedSince(ticks)
+		|| y2.changedSince(ticks) || opacity.changedSince(ticks);
+}
+bool FD_Line::getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+	const std::shared_ptr<const FD_Camera> camera, const double interpolation) const {
+	if (alpha == 0 || !visible) return false;
 	Uint8 colour_alpha = colour.a;
 	if (alpha != 255) {
 		colour_alpha = static_cast<Uint8>(colour.a * (alpha / 255.0)
-			* (opacity->value() / 255.0));
+			* (opacity.value() / 255.0));
 	}
-	SDL_SetRenderDrawColor(renderer, colour.r, colour.g, colour.b, colour_alpha);
 	// Get the dstrect to manipulate
 	int min_x, min_y, max_x, max_y;
 	if (p1 == nullptr || p2 == nullptr) {
-		min_x = static_cast<int>(x1->value());
-		min_y = static_cast<int>(y1->value());
-		max_x = static_cast<int>(x2->value());
-		max_y = static_cast<int>(y2->value());
+		min_x = static_cast<int>(x1.value());
+		min_y = static_cast<int>(y1.value());
+		max_x = static_cast<int>(x2.value());
+		max_y = static_cast<int>(y2.value());
 	} else {
 		min_x = p1->x;
 		min_y = p1->y;
@@ -201,19 +248,20 @@ void FD_Line::render(SDL_Renderer* renderer, const Uint8 alpha,
 		min_y = temp;
 	}
 	SDL_Rect dr{ min_x, min_y, max_x - min_x, max_y - min_y };
-	if (this->isCameraBound()) {
+	if (this->isCameraBound() && camera != nullptr) {
 		double angle;
-		if (!camera->manipulate(dr, angle)) return;
-	}
-	SDL_Rect* old_clip{ nullptr };
-	bool clipping{ clip_rect != nullptr };
-	if (clipping) {
-		SDL_RenderGetClipRect(renderer, old_clip);
-		SDL_RenderSetClipRect(renderer, clip_rect);
+		if (!camera->manipulate(dr, angle)) return false;
 	}
-	SDL_RenderDrawLine(renderer, dr.x, dr.y, dr.x + dr.w, dr.y + dr.h);
-	if (clipping) SDL_RenderSetClipRect(renderer, old_clip);
-	SDL_SetRenderDrawBlendMode(renderer, old_blend);
+	command.type = FD_DRAW_LINE;
+	command.layer = getLayer();
+	command.image = nullptr;
+	command.texture = nullptr;
+	command.dstrect = dr;
+	command.blend = blend_mode;
+	command.has_clip = clip_rect != nullptr;
+	if (command.has_clip) command.clip = *clip_rect;
+	command.colour = { colour.r, colour.g, colour.b, colour_alpha };
+	return true;
 }
 
 void FD_Line::setColour(SDL_Colour colour) { this->colour = colour; }
@@ -223,27 +271,27 @@ void FD_Line::setBlendMode(SDL_BlendMode bm) { this->blend_mode = bm; }
 SDL_Colour FD_Line::getColour() const { return colour; }
 bool FD_Line::isVisible() const { return visible; }
 
-double FD_Line::getX1() const { return x1->value(); }
-double FD_Line::getY1() const { return y1->value(); }
-double FD_Line::getX2() const { return x2->value(); }
-double FD_Line::getY2() const { return y2->value(); }
+double FD_Line::getX1() const { return x1.value(); }
+double FD_Line::getY1() const { return y1.value(); }
+double FD_Line::getX2() const { return x2.value(); }
+double FD_Line::getY2() const { return y2.value(); }
 Uint8 FD_Line::getOpacity() const {
-	return static_cast<int>(opacity->value());
+	return static_cast<int>(opacity.value());
 }
 SDL_BlendMode FD_Line::getBlendMode() const { return blend_mode; }
 
 void FD_Line::updatePoints(double x1, double y1, double x2, double y2) {
-	this->x1->set(x1);
-	this->y1->set(y1);
-	this->x2->set(x2);
-	this->y2->set(y2);
+	this->x1.set(x1);
+	this->y1.set(y1);
+	this->x2.set(x2);
+	this->y2.set(y2);
 }
 
-FD_Tween* FD_Line::getTweenX1() { return x1; }
-FD_Tween* FD_Line::getTweenY1() { return y1; }
-FD_Tween* FD_Line::getTweenX2() { return x2; }
-FD_Tween* FD_Line::getTweenY2() { return y2; }
-FD_Tween* FD_Line::getTweenOpacity() { return opacity; }
+FD_Tween* FD_Line::getTweenX1() { return &x1; }
+FD_Tween* FD_Line::getTweenY1() { return &y1; }
+FD_Tween* FD_Line::getTweenX2() { return &x2; }
+FD_Tween* FD_Line::getTweenY2() { return &y2; }
+FD_Tween* FD_Line::getTweenOpacity() { return &opacity; }
 
 void FD_Line::assimilate(std::shared_ptr<FD_ObjectGroup> group) {
 	group->addObject(shared_from_this());
@@ -252,21 +300,11 @@ void FD_Line::assimilate(std::shared_ptr<FD_ObjectGroup> group) {
 // Box Member Functions
 
 FD_Box::FD_Box(double x, double y, double w, double h, int z,
-	bool camera_bound, SDL_Colour colour) : FD_Layered(z, camera_bound) {
+	bool camera_bound, SDL_Colour colour) : FD_Layered(z, camera_bound),
+	x{ x }, y{ y }, w{ w }, h{ h } {
 	this->colour = colour;
-	this->x = new FD_Tween(x);
-	this->y = new FD_Tween(y);
-	this->w = new FD_Tween(w);
-	this->h = new FD_Tween(h);
-	this->opacity = new FD_Tween(255);
-}
-FD_Box::~FD_Box() {
-	delete x;
-	delete y;
-	delete w;
-	delete h;
-	delete opacity;
 }
+FD_Box::~FD_Box() {}
 
 void FD_Box::removeRect() {
 	rect = nullptr;
@@ -282,49 +320,60 @@ void FD_Box::removeClipRect() {
 	this->clip_rect = nullptr;
 }
 
-void FD_Box::render(SDL_Renderer* renderer, const Uint8 alpha,
-	const std::shared_ptr<const FD_Camera> camera) const {
-	if (alpha == 0 || !visible) return;
+bool FD_Box::hasChangedSince(Uint32 ticks) const {
+	return x.changedSince(ticks) || y.changedSince(ticks) || w.changedSince(ticks)
+		|| h.changedSince(ticks) || opacity.changedSince(ticks);
+}
+bool FD_Box::getCullingBounds(SDL_Rect& bounds) const {
+	if (!isCameraBound()) return false;
+	if (rect == nullptr) {
+		// Cover where the tweens are and, where they are going
+		SDL_Rect now{ static_cast<int>(x.value()), static_cast<int>(y.value()),
+			static_cast<int>(w.value()), static_cast<int>(h.value()) };
+		SDL_Rect next{ static_cast<int>(x.destination()), static_cast<int>(y.destination()),
+			static_cast<int>(w.destination()), static_cast<int>(h.destination()) };
+		SDL_UnionRect(&now, &next, &bounds);
+	} else {
+		bounds = *rect;
+	}
+	return true;
+}
+bool FD_Box::getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+	const std::shared_ptr<const FD_Camera> camera, const double interpolation) const {
+	if (alpha == 0 || !visible) return false;
 	Uint8 colour_alpha = static_cast<Uint8>(colour.a * (alpha / 255.0)
-		* (opacity->value() / 255.0));
+		* (opacity.value() / 255.0));
 	Uint8 underlay_alpha = static_cast<Uint8>(underlay_colour.a * (alpha / 255.0)
-		* (opacity->value() / 255.0));
+		* (opacity.value() / 255.0));
 	Uint8 overlay_alpha = static_cast<Uint8>(overlay_colour.a * (alpha / 255.0)
-		* (opacity->value() / 255.0));
+		* (opacity.value() / 255.0));
 	SDL_Rect dr{};
 	if (rect == nullptr) {
-		dr.x = static_cast<int>(x->value());
-		dr.y = static_cast<int>(y->value());
-		dr.w = static_cast<int>(w->value());
-		dr.h = static_cast<int>(h->value());
+		dr.x = static_cast<int>(x.value());
+		dr.y = static_cast<int>(y.value());
+		dr.w = static_cast<int>(w.value());
+		dr.h = static_cast<int>(h.value());
 	} else {
 		dr = SDL_Rect(*rect);
 	}
-	if (this->isCameraBound()) {
+	if (this->isCameraBound() && camera != nullptr) {
 		double angle;
-		if (!camera->manipulate(dr, angle)) return;
+		if (!camera->manipulate(dr, angle)) return false;
 	}
-	SDL_Rect* old_clip{ nullptr };
-	bool clipping{ clip_rect != nullptr };
-	if (clipping) {
-		SDL_RenderGetClipRect(renderer, old_clip);
-		SDL_RenderSetClipRect(renderer, clip_rect);
-	}
-	SDL_BlendMode old_blend{ };
-	SDL_GetRenderDrawBlendMode(renderer, &old_blend);
-	SDL_SetRenderDrawBlendMode(renderer, blend_mode);
-
-	SDL_SetRenderDrawColor(renderer, underlay_colour.r,
-		underlay_colour.g, underlay_colour.b, underlay_alpha);
-	SDL_RenderFillRect(renderer, &dr);
-	SDL_SetRenderDrawColor(renderer, colour.r, colour.g, colour.b, colour_alpha);
-	SDL_RenderDrawRect(renderer, &dr);
-	SDL_SetRenderDrawColor(renderer, overlay_colour.r,
-		overlay_colour.g, overlay_colour.b, overlay_alpha);
-	SDL_RenderFillRect(renderer, &dr);
-
-	if (clipping) SDL_RenderSetClipRect(renderer, old_clip);
-	SDL_SetRenderDrawBlendMode(renderer, old_blend);
+	command.type = FD_DRAW_BOX;
+	command.layer = getLayer();
+	command.image = nullptr;
+	command.texture = nullptr;
+	command.dstrect = dr;
+	command.blend = blend_mode;
+	command.has_clip = clip_rect != nullptr;
+	if (command.has_clip) command.clip = *clip_rect;
+	command.underlay_colour = { underlay_colour.r, underlay_colour.g,
+		underlay_colour.b, underlay_alpha };
+	command.colour = { colour.r, colour.g, colour.b, colour_alpha };
+	command.overlay_colour = { overlay_colour.r, overlay_colour.g,
+		overlay_colour.b, overlay_alpha };
+	return true;
 }
 
 void FD_Box::setUnderlayColour(SDL_Colour colour) { this->underlay_colour = colour; }
@@ -340,29 +389,29 @@ void FD_Box::setBlendMode(SDL_BlendMode bm) {
 	this->blend_mode = bm;
 }
 
-double FD_Box::getX() const { return x->value(); }
-double FD_Box::getY() const { return y->value(); }
-double FD_Box::getWidth() const { return w->value(); }
-double FD_Box::getHeight() const { return h->value(); }
+double FD_Box::getX() const { return x.value(); }
+double FD_Box::getY() const { return y.value(); }
+double FD_Box::getWidth() const { return w.value(); }
+double FD_Box::getHeight() const { return h.value(); }
 Uint8 FD_Box::getOpacity() const {
-	return static_cast<int>(opacity->value());
+	return static_cast<int>(opacity.value());
 }
 SDL_BlendMode FD_Box::getBlendMode() const {
 	return blend_mode;
 }
 
 void FD_Box::updateRect(double x, double y, double w, double h) {
-	this->x->set(x);
-	this->y->set(y);
-	this->w->set(w);
-	this->h->set(h);
+	this->x.set(x);
+	this->y.set(y);
+	this->w.set(w);
+	this->h.set(h);
 }
 
-FD_Tween* FD_Box::getTweenX() { return x; }
-FD_Tween* FD_Box::getTweenY() { return y; }
-FD_Tween* FD_Box::getTweenWidth() { return w; }
-FD_Tween* FD_Box::getTweenHeight() { return h; }
-FD_Tween* FD_Box::getTweenOpacity() { return opacity; }
+FD_Tween* FD_Box::getTweenX() { return &x; }
+FD_Tween* FD_Box::getTweenY() { return &y; }
+FD_Tween* FD_Box::getTweenWidth() { return &w; }
+FD_Tween* FD_Box::getTweenHeight() { return &h; }
+FD_Tween* FD_Box::getTweenOpacity() { return &opacity; }
 
 void FD_Box::assimilate(std::shared_ptr<FD_ObjectGroup> group) {
 	group->addObject(shared_from_this());
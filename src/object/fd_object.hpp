@@ -33,11 +33,11 @@ class FD_Line : public FD_Layered, public std::enable_shared_from_this<FD_Line>
 private:
 
 	SDL_Colour colour;
-	FD_Tween* x1;
-	FD_Tween* y1;
-	FD_Tween* x2;
-	FD_Tween* y2;
-	FD_Tween* opacity;
+	FD_Tween x1;
+	FD_Tween y1;
+	FD_Tween x2;
+	FD_Tween y2;
+	FD_Tween opacity;
 
 	bool visible{ true };
 
@@ -90,14 +90,32 @@ public:
 	*/
 	void removeClipRect();
 
-	//! Renders the FD_Line.
+	//! Fills in the command that draws the FD_Line.
 	/*!
-		\param renderer The renderer to be used.
-		\param alpha    The overall opacity, usually given by an object group - applied multiplicatively to the FD_Line opacity.
-		\param camera   The camera to use for camera bound operations. 
+		\param command       The command to fill in.
+		\param alpha         The overall opacity, usually given by an object group - applied multiplicatively to the FD_Line opacity.
+		\param camera        The camera to use for camera bound operations, or nullptr to leave them to the object group.
+		\param interpolation How far the loop is between the last update and the next, unused as the FD_Line is drawn from its tweens.
+
+		\return Whether the FD_Line should be drawn.
 	*/
-	void render(SDL_Renderer* renderer, const Uint8 alpha,
-		const std::shared_ptr<const FD_Camera> camera) const override;
+	bool getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+		const std::shared_ptr<const FD_Camera> camera,
+		const double interpolation) const override;
+	//! Returns the area the FD_Line covers, before the camera manipulates it.
+	/*!
+		\param bounds The rectangle to write the area to.
+
+		\return Whether the FD_Line is camera bound and so has bounds.
+	*/
+	bool getCullingBounds(SDL_Rect& bounds) const override;
+	//! Returns whether the tweens of the FD_Line have changed since a given time.
+	/*!
+		\param ticks The engine time to check from.
+
+		\return Whether the FD_Line may be drawn differently since the time.
+	*/
+	bool hasChangedSince(Uint32 ticks) const override;
 
 	//! Sets the colour of the line.
 	/*!
@@ -219,11 +237,11 @@ private:
 	SDL_Colour underlay_colour{ 0, 0, 0, 0 };
 	SDL_Colour colour;
 	SDL_Colour overlay_colour{ 0, 0, 0, 0 };
-	FD_Tween* x;
-	FD_Tween* y;
-	FD_Tween* w;
-	FD_Tween* h;
-	FD_Tween* opacity;
+	FD_Tween x;
+	FD_Tween y;
+	FD_Tween w;
+	FD_Tween h;
+	FD_Tween opacity;
 
 	bool visible{ true };
 
@@ -276,14 +294,32 @@ public:
 	*/
 	void removeClipRect();
 
-	//! Renders the FD_Box.
+	//! Fills in the command that draws the FD_Box.
 	/*!
-		\param renderer The renderer to be used.
-		\param alpha    The overall opacity, usually given by an object group - applied multiplicatively to the FD_Box opacity.
-		\param camera   The camera to use for camera bound operations. 
+		\param command       The command to fill in.
+		\param alpha         The overall opacity, usually given by an object group - applied multiplicatively to the FD_Box opacity.
+		\param camera        The camera to use for camera bound operations, or nullptr to leave them to the object group.
+		\param interpolation How far the loop is between the last update and the next, unused as the FD_Box is drawn from its tweens.
+
+		\return Whether the FD_Box should be drawn.
 	*/
-	void render(SDL_Renderer* renderer, const Uint8 alpha,
-		const std::shared_ptr<const FD_Camera> camera) const override;
+	bool getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+		const std::shared_ptr<const FD_Camera> camera,
+		const double interpolation) const override;
+	//! Returns the area the FD_Box covers, before the camera manipulates it.
+	/*!
+		\param bounds The rectangle to write the area to.
+
+		\return Whether the FD_Box is camera bound and so has bounds.
+	*/
+	bool getCullingBounds(SDL_Rect& bounds) const override;
+	//! Returns whether the tweens of the FD_Box have changed since a given time.
+	/*!
+		\param ticks The engine time to check from.
+
+		\return Whether the FD_Box may be drawn differently since the time.
+	*/
+	bool hasChangedSince(Uint32 ticks) const override;
 
 	//! Sets the colour of the outline of the box.
 	/*!
@@ -426,25 +462,32 @@ class FD_Object : public FD_Layered {
 protected:
 
 	//! The tween corresponding to the x-coordinate.
-	FD_Tween* x;
+	FD_Tween x;
 	//! The tween corresponding to the y-coordinate.
-	FD_Tween* y;
+	FD_Tween y;
 	//! The tween corresponding to the width.
-	FD_Tween* w;
+	FD_Tween w;
 	//! The tween corresponding to the height.
-	FD_Tween* h;
+	FD_Tween h;
 	//! The tween corresponding to the angle.
-	FD_Tween* angle;
+	FD_Tween angle;
 	//! The tween corresponding to the horizontal scale.
-	FD_Tween* scale_w;
+	FD_Tween scale_w;
 	//! The tween corresponding to the vertical scale.
-	FD_Tween* scale_h;
+	FD_Tween scale_h;
 	//! The tween corresponding to the opacity.
-	FD_Tween* opacity;
+	FD_Tween opacity;
 	//! Whether the object is visible or not.
 	bool visible{ true };
 
+	//! The storage held inline for the source rectangle, pointed to by srcrect when used.
+	SDL_Rect owned_srcrect{ };
+	//! The storage held inline for the destination rectangle, pointed to by dstrect when used.
+	SDL_Rect owned_dstrect{ };
 	//! The source rectangle of the object.
+	/*!
+		This is nullptr when the whole image is drawn, otherwise it usually points to owned_srcrect.
+	*/
 	SDL_Rect* srcrect{ nullptr };
 	//! The destination rectangle of the object.
 	/*!
@@ -459,13 +502,13 @@ protected:
 		This value is relative to the x-coordinate and is in units of the width of
 		the object.
 	*/
-	FD_Tween* center_x;
+	FD_Tween center_x;
 	//! The tween corresponding to the y-coordinate of the rotational center.
 	/*!
 		This value is relative to the y-coordinate and is in units of the height of
 		the object.
 	*/
-	FD_Tween* center_y;
+	FD_Tween center_y;
 
 	//! The draw style of the object.
 	FD_DrawStyle draw_style{ FD_CENTERED };
@@ -476,6 +519,15 @@ protected:
 	//! The clipping rectangle of the object
 	SDL_Rect* clip_rect{ nullptr };
 
+	//! Whether the object is drawn between its last two updates.
+	bool interpolated{ false };
+	//! Whether the destination rectangle has been recorded by tick.
+	bool ticked{ false };
+	//! The destination rectangle at the end of the second to last update.
+	SDL_Rect previous_dstrect{ };
+	//! The destination rectangle at the end of the last update.
+	SDL_Rect ticked_dstrect{ };
+
 	//! This updates a rectangle with respect to the given parameters.
 	/*!
 		\param rect  The pointer to the rectangle to update.
@@ -525,14 +577,55 @@ public:
 		Uint8 opacity = 255, bool visible = true);
 	~FD_Object();
 
-	//! Renders the object.
+	//! Fills in the command that draws the object.
+	/*!
+		If the object is interpolated, its destination rectangle is blended between
+		its last two updates by the interpolation.
+
+		\param command       The command to fill in.
+		\param alpha         The overall opacity, usually given by an object group - applied multiplicatively to the FD_Box opacity.
+		\param camera        The camera to use for camera bound operations, or nullptr to leave them to the object group.
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
+
+		\return Whether the object should be drawn.
+
+		\sa setInterpolated
+	*/
+	bool getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+		const std::shared_ptr<const FD_Camera> camera,
+		const double interpolation) const override;
+	//! Returns the area the object covers, before the camera manipulates it.
+	/*!
+		This covers both of the destination rectangles drawn between when interpolated.
+
+		\param bounds The rectangle to write the area to.
+
+		\return Whether the object is camera bound and has a destination rectangle.
+	*/
+	bool getCullingBounds(SDL_Rect& bounds) const override;
+	//! Returns whether the tweens of the object have changed since a given time.
+	/*!
+		\param ticks The engine time to check from.
+
+		\return Whether the object may be drawn differently since the time.
+	*/
+	bool hasChangedSince(Uint32 ticks) const override;
+	//! Records the destination rectangle of the object at the end of an update cycle.
+	void tick() override;
+
+	//! Sets whether the object is drawn between its last two updates.
+	/*!
+		Interpolating allows the update rate to be lowered without motion
+		stuttering, at the cost of drawing the object one update behind.
+
+		\param interpolated Whether the object should be interpolated.
+	*/
+	void setInterpolated(bool interpolated);
+	//! Returns whether the object is drawn between its last two updates.
 	/*!
-		\param renderer The renderer to be used.
-		\param alpha    The overall opacity, usually given by an object group - applied multiplicatively to the FD_Box opacity.
-		\param camera   The camera to use for camera bound operations.
+		\return Whether the object is drawn between its last two updates.
 	*/
-	void render(SDL_Renderer* renderer, const Uint8 alpha,
-		const std::shared_ptr<const FD_Camera> camera) const override;
+	bool isInterpolated() const;
 
 	//! Returns the x-coordinate of the object.
 	/*!
@@ -0,0 +1,93 @@
+#include "fd_objectArena.hpp"
+
+#include <new>
+#include <algorithm>
+
+FD_ObjectArena::FD_ObjectArena() : classes(max_size / granularity) {}
+FD_ObjectArena::~FD_ObjectArena() {}
+
+FD_ObjectArena::Chunk*& FD_ObjectArena::owner(void* slot) {
+	return *reinterpret_cast<Chunk**>(static_cast<unsigned char*>(slot) - header);
+}
+void*& FD_ObjectArena::next(void* slot) {
+	return *static_cast<void**>(slot);
+}
+size_t FD_ObjectArena::stride(size_t c) {
+	return header + (c + 1) * granularity;
+}
+bool FD_ObjectArena::handles(size_t size, size_t alignment) const {
+	return size <= max_size && alignment <= alignof(std::max_align_t);
+}
+void FD_ObjectArena::grow(size_t c) {
+	SizeClass& sc{ classes[c] };
+	std::unique_ptr<Chunk> chunk{ std::make_unique<Chunk>() };
+	chunk->memory = std::make_unique<unsigned char[]>(stride(c) * chunk_slots);
+	// Thread the slots onto the free list, the first slot ending up at its front
+	for (size_t i = chunk_slots; i > 0; i--) {
+		void* slot{ chunk->memory.get() + (i - 1) * stride(c) + header };
+		owner(slot) = chunk.get();
+		next(slot) = sc.free;
+		sc.free = slot;
+	}
+	sc.chunks.push_back(std::move(chunk));
+}
+
+void* FD_ObjectArena::allocate(size_t size, size_t alignment) {
+	if (!handles(size, alignment)) return ::operator new(size);
+	size_t c{ size == 0 ? 0 : (size - 1) / granularity };
+	std::lock_guard<std::mutex> lock{ mutex };
+	SizeClass& sc{ classes[c] };
+	if (sc.free == nullptr) grow(c);
+	void* slot{ sc.free };
+	sc.free = next(slot);
+	owner(slot)->used++;
+	used++;
+	return slot;
+}
+void FD_ObjectArena::deallocate(void* p, size_t size, size_t alignment) {
+	if (p == nullptr) return;
+	if (!handles(size, alignment)) {
+		::operator delete(p);
+		return;
+	}
+	size_t c{ size == 0 ? 0 : (size - 1) / granularity };
+	std::lock_guard<std::mutex> lock{ mutex };
+	SizeClass& sc{ classes[c] };
+	owner(p)->used--;
+	next(p) = sc.free;
+	sc.free = p;
+	used--;
+}
+void FD_ObjectArena::release() {
+	std::lock_guard<std::mutex> lock{ mutex };
+	for (SizeClass& sc : classes) {
+		bool unused{ false };
+		for (auto& chunk : sc.chunks) unused = unused || chunk->used == 0;
+		if (!unused) continue;
+		// Drop the slots of unused chunks from the free list, then the chunks
+		void** link{ &sc.free };
+		while (*link != nullptr) {
+			if (owner(*link)->used == 0) {
+				*link = next(*link);
+			} else {
+				link = &next(*link);
+			}
+		}
+		sc.chunks.erase(std::remove_if(sc.chunks.begin(), sc.chunks.end(),
+			[](const std::unique_ptr<Chunk>& chunk) { return chunk->used == 0; }),
+			sc.chunks.end());
+	}
+}
+
+size_t FD_ObjectArena::getUsed() const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	return used;
+}
+size_t FD_ObjectArena::getReserved() const {
+	std::lock_guard<std::mutex> lock{ mutex };
+	size_t reserved{ 0 };
+	for (size_t c = 0; c < classes.size(); c++) {
+		reserved += classes[c].chunks.size() * stride(c) * chunk_slots;
+	}
+	return reserved;
+}
@@ -0,0 +1,156 @@
+#ifndef FD_OBJECT_ARENA_H_
+#define FD_OBJECT_ARENA_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+
+/*!
+	@file
+	@brief The file containing the FD_ObjectArena class and, its allocator.
+*/
+
+//! The class that hands out memory for many small objects from large chunks.
+/*!
+	Allocations are rounded up to a size class, each with a free list of slots
+	cut from chunks. Freed slots are reused by the next allocation of their
+	class, so creating and destroying objects repeatedly doesn't reach the
+	system allocator and, objects made together sit together in memory.
+	Chunks are kept until release is called, which frees those that are
+	wholly unused, usually as a state sleeps.
+
+	The arena is given to std::allocate_shared via FD_ArenaAllocator, which
+	keeps the arena alive for as long as anything allocated from it.
+
+	\sa FD_ArenaAllocator
+	\sa FD_Factory
+*/
+class FD_ObjectArena {
+private:
+
+	struct Chunk {
+		std::unique_ptr<unsigned char[]> memory{};
+		size_t used{ 0 };
+	};
+	struct SizeClass {
+		std::vector<std::unique_ptr<Chunk>> chunks{};
+		void* free{ nullptr };
+	};
+
+	// Each slot starts with a header pointing to its chunk
+	static const size_t header{ alignof(std::max_align_t) > sizeof(Chunk*)
+		? alignof(std::max_align_t) : sizeof(Chunk*) };
+
+	mutable std::mutex mutex{};
+	std::vector<SizeClass> classes{};
+	size_t used{ 0 };
+
+	static Chunk*& owner(void* slot);
+	static void*& next(void* slot);
+	static size_t stride(size_t c);
+	bool handles(size_t size, size_t alignment) const;
+	void grow(size_t c);
+
+public:
+
+	//! The granularity of the size classes in bytes.
+	static const size_t granularity{ 16 };
+	//! The largest allocation served by the arena in bytes, larger allocations use the system allocator.
+	static const size_t max_size{ 1024 };
+	//! The number of slots cut from each chunk.
+	static const size_t chunk_slots{ 64 };
+
+	//! Constructs a FD_ObjectArena.
+	FD_ObjectArena();
+	//! Destroys the FD_ObjectArena.
+	~FD_ObjectArena();
+
+	//! Allocates memory.
+	/*!
+		\param size      The number of bytes.
+		\param alignment The alignment of the memory.
+
+		\return The memory.
+	*/
+	void* allocate(size_t size, size_t alignment);
+	//! Frees memory allocated by the arena.
+	/*!
+		\param p         The memory.
+		\param size      The number of bytes given when the memory was allocated.
+		\param alignment The alignment given when the memory was allocated.
+	*/
+	void deallocate(void* p, size_t size, size_t alignment);
+	//! Frees every chunk with no slots in use.
+	void release();
+
+	//! Returns the number of slots in use.
+	/*!
+		\return The number of slots in use.
+	*/
+	size_t getUsed() const;
+	//! Returns the number of bytes held in chunks.
+	/*!
+		\return The number of bytes held in chunks.
+	*/
+	size_t getReserved() const;
+
+};
+
+//! The allocator that allocates from a FD_ObjectArena, for use with std::allocate_shared.
+/*!
+	\sa FD_ObjectArena
+*/
+template <class T>
+class FD_ArenaAllocator {
+private:
+
+	template <class U> friend class FD_ArenaAllocator;
+
+	std::shared_ptr<FD_ObjectArena> arena;
+
+public:
+
+	//! The type allocated.
+	using value_type = T;
+
+	//! Constructs a FD_ArenaAllocator.
+	/*!
+		\param arena The arena to allocate from.
+	*/
+	FD_ArenaAllocator(std::shared_ptr<FD_ObjectArena> arena) : arena{ arena } {}
+	//! Constructs a FD_ArenaAllocator from an allocator of another type, sharing its arena.
+	/*!
+		\param other The other allocator.
+	*/
+	template <class U>
+	FD_ArenaAllocator(const FD_ArenaAllocator<U>& other) : arena{ other.arena } {}
+
+	//! Allocates memory for a number of objects.
+	/*!
+		\param n The number of objects.
+
+		\return The memory.
+	*/
+	T* allocate(size_t n) {
+		return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+	}
+	//! Frees memory for a number of objects.
+	/*!
+		\param p The memory.
+		\param n The number of objects.
+	*/
+	void deallocate(T* p, size_t n) {
+		arena->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	//! Returns whether two allocators share an arena.
+	template <class U>
+	bool operator==(const FD_ArenaAllocator<U>& other) const { return arena == other.arena; }
+	//! Returns whether two allocators don't share an arena.
+	template <class U>
+	bool operator!=(const FD_ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+};
+
+#endif
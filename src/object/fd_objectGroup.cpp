@@ -1,5 +1,10 @@
 #include "fd_objectGroup.hpp"
 
+#include <algorithm>
+
+#include "../main/fd_profiler.hpp"
+#include "../maths/fd_clock.hpp"
+
 // FD_Layered Member Functions
 
 FD_Layered::FD_Layered(int z, bool camera_bound) {
@@ -8,6 +13,17 @@ FD_Layered::FD_Layered(int z, bool camera_bound) {
 }
 FD_Layered::~FD_Layered() {}
 
+void FD_Layered::render(SDL_Renderer* renderer, const Uint8 alpha,
+	const std::shared_ptr<const FD_Camera> camera, const double interpolation) const {
+	FD_DrawCommand command{ };
+	if (getDrawCommand(command, alpha, camera, interpolation)) command.execute(renderer);
+}
+bool FD_Layered::getCullingBounds(SDL_Rect& bounds) const { return false; }
+bool FD_Layered::hasChangedSince(Uint32 ticks) const { return false; }
+void FD_Layered::tick() {}
+bool FD_Layered::hasEvents() const { return false; }
+void FD_Layered::deliverEvents() {}
+
 void FD_Layered::setLayer(int z) {
 	if (z != this->z) {
 		re_layered = true;
@@ -30,91 +46,262 @@ bool FD_Layered::hasChangedLayer() {
 
 // FD_Object Group Member Functions
 
-FD_ObjectGroup::FD_ObjectGroup(const int id) : id{ id } {
-	opacity = new FD_Tween(255);
-}
-FD_ObjectGroup::~FD_ObjectGroup() {
-	delete opacity;
-}
+FD_ObjectGroup::FD_ObjectGroup(const int id) : id{ id }, opacity{ 255 } {}
+FD_ObjectGroup::~FD_ObjectGroup() {}
 
 void FD_ObjectGroup::update() {
-	std::vector<std::shared_ptr<FD_Layered>> to_readd{};
-	auto it = list.begin();
-	while (it != list.end()) {
-		if ((*it).use_count() == 1) {
-			it = list.erase(it);
-		} else if ((*it)->hasChangedLayer()) {
-			to_readd.push_back((*it));
-			it = list.erase(it);
+	updateObjects();
+	deliverEvents();
+	updateCameras();
+}
+void FD_ObjectGroup::updateObjects(std::shared_ptr<FD_JobSystem> jobs) {
+	FD_PROFILE_ZONE("FD_ObjectGroup::update");
+	// Remove the released objects and take out the re-layered ones, a layer at a time
+	for (auto b = buckets.begin(); b != buckets.end();) {
+		std::vector<std::shared_ptr<FD_Layered>>& objects{ b->second };
+		size_t kept{ 0 };
+		for (size_t i = 0; i < objects.size(); i++) {
+			if (objects[i].use_count() == 1) continue;
+			if (objects[i]->hasChangedLayer()) {
+				relayered.push_back(std::move(objects[i]));
+			} else {
+				if (kept != i) objects[kept] = std::move(objects[i]);
+				kept++;
+			}
+		}
+		if (kept != objects.size()) {
+			objects.resize(kept);
+			reordered = true;
+			grid_dirty = true;
+		}
+		if (objects.empty()) {
+			b = buckets.erase(b);
 		} else {
-			it++;
+			++b;
+		}
+	}
+	for (auto& o : relayered) this->addObject(o);
+	relayered.clear();
+	const std::vector<Entry>& list{ order() };
+	if (grid != nullptr) {
+		grid_bounds.resize(list.size());
+		grid_bounded.resize(list.size());
+	}
+	// Tick the objects, spreading large groups across the job system
+	if (jobs != nullptr) {
+		jobs->parallelFor(0, list.size(), tick_grain, [this, &list](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) list[i].object->tick();
+			if (grid != nullptr) measure(begin, end);
+			if (cache != nullptr) watch(begin, end);
+			collect(begin, end);
+		});
+	} else {
+		for (const Entry& e : list) e.object->tick();
+		if (grid != nullptr) measure(0, list.size());
+		if (cache != nullptr) watch(0, list.size());
+		collect(0, list.size());
+	}
+	if (grid != nullptr) reindex();
+	checked_at = FD_Clock::getTicks();
+}
+const std::vector<FD_ObjectGroup::Entry>& FD_ObjectGroup::order() const {
+	if (reordered) {
+		ordered.clear();
+		for (const auto& b : buckets) {
+			for (const auto& o : b.second) ordered.push_back({ o.get(), b.first });
 		}
+		reordered = false;
+		revision++;
 	}
-	for (auto o : to_readd) this->addObject(o);
+	return ordered;
+}
+void FD_ObjectGroup::measure(size_t begin, size_t end) {
+	const std::vector<Entry>& list{ order() };
+	for (size_t i = begin; i < end; i++) {
+		grid_bounded[i] = list[i].object->getCullingBounds(grid_bounds[i]);
+	}
+}
+void FD_ObjectGroup::reindex() {
+	const std::vector<Entry>& list{ order() };
+	// Indices shift as objects are added and removed, so start again
+	if (grid_dirty) {
+		grid->reset(list.size());
+		grid_dirty = false;
+	}
+	for (size_t i = 0; i < list.size(); i++) {
+		grid->set(static_cast<Uint32>(i), grid_bounded[i] != 0, grid_bounds[i]);
+	}
+}
+void FD_ObjectGroup::watch(size_t begin, size_t end) {
+	const std::vector<Entry>& list{ order() };
+	for (size_t i = begin; i < end && !cache_dirty; i++) {
+		if (list[i].object->hasChangedSince(checked_at)) cache_dirty = true;
+	}
+}
+void FD_ObjectGroup::collect(size_t begin, size_t end) {
+	const std::vector<Entry>& list{ order() };
+	for (size_t i = begin; i < end; i++) {
+		if (!list[i].object->hasEvents()) continue;
+		std::lock_guard<std::mutex> lock{ eventful_mutex };
+		eventful.push_back(static_cast<Uint32>(i));
+	}
+}
+void FD_ObjectGroup::deliverEvents() {
+	if (eventful.empty()) return;
+	// Chunks finish in any order, and listeners may change the group
+	std::sort(eventful.begin(), eventful.end());
+	const std::vector<Entry>& list{ order() };
+	for (Uint32 i : eventful) delivering.push_back(list[i].object);
+	eventful.clear();
+	for (FD_Layered* o : delivering) o->deliverEvents();
+	delivering.clear();
+}
+void FD_ObjectGroup::updateCameras() {
 	if (auto set = cameras.lock()) set->update();
 }
 
 void FD_ObjectGroup::pre_render() {
-	if (auto set = cameras.lock()) set->pre_render();
+	staging = true;
+	std::shared_ptr<FD_CameraSet> set{ cameras.lock() };
+	if (set != nullptr) set->pre_render();
+	if (cache != nullptr) {
+		// Camera bound objects are drawn differently once the camera changes
+		if (cache_bound && set != nullptr) {
+			if (auto c = set->getCurrentCamera().lock()) {
+				if (c.get() != cached_camera || c->hasChangedSince(viewed_at)) cache_dirty = true;
+				cached_camera = c.get();
+			}
+		}
+		viewed_at = FD_Clock::getTicks();
+		if (cache->hasBeenLost() || getRevision() != cached_revision) cache_dirty = true;
+		return;
+	}
+	if (grid == nullptr) return;
+	// Index any objects added since the last update
+	if (grid_dirty) {
+		size_t size{ order().size() };
+		grid_bounds.resize(size);
+		grid_bounded.resize(size);
+		measure(0, size);
+		reindex();
+	}
+	previously_drawn.swap(drawn);
+	drawn.clear();
+	if (set != nullptr) {
+		if (auto c = set->getCurrentCamera().lock()) {
+			grid->query(*c->getCullingBounds(), drawn);
+		}
+	}
+	if (drawn != previously_drawn) revision++;
 }
-void FD_ObjectGroup::render(const size_t index, SDL_Renderer* renderer) const {
+void FD_ObjectGroup::render(const size_t index, SDL_Renderer* renderer,
+	const double interpolation) const {
+	const std::vector<Entry>& list{ order() };
 	if (index >= list.size()) return;
 	if (!visible) return;
 	if (auto set = cameras.lock()) {
 		if (auto c = set->getCurrentCamera().lock()) {
-			list.at(index)->render(renderer, this->getOpacity(), c);
+			list[index].object->render(renderer, this->getOpacity(), c, interpolation);
 		}
 	}
 }
-void FD_ObjectGroup::render_all(SDL_Renderer* renderer) const {
+void FD_ObjectGroup::render_all(SDL_Renderer* renderer,
+	const double interpolation) const {
 	if (!visible) return;
+	if (cache != nullptr) {
+		FD_RenderSnapshot snapshot{};
+		record(0, snapshot, interpolation);
+		snapshot.execute(renderer);
+		return;
+	}
 	if (auto set = cameras.lock()) {
 		if (auto c = set->getCurrentCamera().lock()) {
-			for (auto o : list) o->render(renderer, this->getOpacity(), c);
+			for (size_t p = 0; p < getDrawCount(); p++) {
+				order()[getDrawIndex(p)].object->render(renderer, this->getOpacity(), c, interpolation);
+			}
 		}
 	}
 }
 
-void FD_ObjectGroup::addObject(const std::shared_ptr<FD_Layered> o) {
-	// It's necessary to put the object in at the right z layer
-	// position, as the list is ascending, binary search is used
-	int layer{ o->getLayer() };
-	size_t upper{ list.size() };
-	size_t lower{ 0 };
-	size_t mid{ static_cast<size_t>(std::floor((lower / 2.0) + (upper / 2.0))) };
-	while (upper - lower > 0) {
-		// Edge case breakdown
-		if (upper - lower == 1) {
-			int u_l{ 0 };
-			if (upper == list.size()) {
-				u_l = list.back()->getLayer();
-			} else {
-				u_l = list.at(upper)->getLayer();
-			}
-			int l_l = list.at(lower)->getLayer();
-			if (layer < u_l) {
-				if (layer > l_l) {
-					mid = upper;
-				} else {
-					mid = lower;
-				}
-			} else {
-				mid = upper;
+void FD_ObjectGroup::record(const size_t index, FD_RenderSnapshot& snapshot,
+	const double interpolation) const {
+	const std::vector<Entry>& list{ order() };
+	if (index >= list.size()) return;
+	if (!visible) return;
+	if (cache != nullptr) {
+		Uint8 alpha{ this->getOpacity() };
+		if (alpha == 0) return;
+		if (cache_dirty) {
+			// Record every object at full opacity, the group's is applied to the copy
+			if (!stage(true, 255, interpolation)) return;
+			cache_bound = false;
+			for (size_t p = 0; p < staged.size(); p++) {
+				cache_bound = cache_bound || list[p].object->isCameraBound();
+				if (staged_drawn[p]) cache_recording.add() = std::move(staged[p]);
 			}
-			break;
+			cache->submit(cache_recording);
+			cache_dirty = false;
+			cached_revision = revision;
 		}
-		// Recursive element
-		mid = static_cast<int>(std::floor((lower / 2.0) + (upper / 2.0)));
-		if (list.at(mid)->getLayer() == layer) {
-			break;
-		} else if (list.at(mid)->getLayer() < layer) {
-			lower = mid;
-		} else {
-			upper = mid;
+		FD_DrawCommand& command{ snapshot.add() };
+		command.type = FD_DRAW_IMAGE;
+		command.layer = list[0].layer;
+		command.image = cache;
+		// The cache remakes its texture as it's drawn, so it can't be read here
+		command.texture = nullptr;
+		command.alpha = alpha;
+		command.has_srcrect = false;
+		command.dstrect = { 0, 0, 0, 0 };
+		command.angle = 0;
+		command.center_x = command.center_y = 0.5;
+		command.flip = SDL_FLIP_NONE;
+		command.blend = FD_GroupCache::getCompositeBlendMode();
+		command.has_clip = false;
+		return;
+	}
+	if (staging) {
+		staged_ok = stage(false, this->getOpacity(), interpolation);
+		staging = false;
+	}
+	size_t p{ getDrawPosition(index) };
+	if (!staged_ok || p >= staged.size() || !staged_drawn[p]) return;
+	snapshot.add() = std::move(staged[p]);
+	staged_drawn[p] = 0;
+}
+bool FD_ObjectGroup::stage(bool all, Uint8 alpha, const double interpolation) const {
+	std::shared_ptr<FD_CameraSet> set{ cameras.lock() };
+	std::shared_ptr<FD_Camera> c{ set == nullptr ? nullptr : set->getCurrentCamera().lock() };
+	if (c == nullptr) return false;
+	const std::vector<Entry>& list{ order() };
+	size_t count{ all ? list.size() : getDrawCount() };
+	staged.resize(count);
+	staged_drawn.resize(count);
+	staged_bound.clear();
+	staged_rects.clear();
+	// Make the commands without the camera, gathering the destinations it should manipulate
+	for (size_t p = 0; p < count; p++) {
+		const FD_Layered* o{ list[all ? p : getDrawIndex(p)].object };
+		bool d{ o->getDrawCommand(staged[p], alpha, nullptr, interpolation) };
+		staged_drawn[p] = d;
+		if (d && o->isCameraBound()) {
+			staged_bound.push_back(static_cast<Uint32>(p));
+			staged_rects.push_back(staged[p].dstrect);
 		}
 	}
-	list.insert(list.begin() + mid, o);
-	return;
+	staged_visible.resize(staged_rects.size());
+	c->manipulateAll(staged_rects.data(), staged_visible.data(), staged_rects.size());
+	for (size_t k = 0; k < staged_bound.size(); k++) {
+		FD_DrawCommand& command{ staged[staged_bound[k]] };
+		command.dstrect = staged_rects[k];
+		staged_drawn[staged_bound[k]] = staged_visible[k];
+	}
+	return true;
+}
+
+void FD_ObjectGroup::addObject(const std::shared_ptr<FD_Layered> o) {
+	buckets[o->getLayer()].push_back(o);
+	reordered = true;
+	grid_dirty = true;
 }
 void FD_ObjectGroup::addObjects(const std::vector<std::shared_ptr<FD_Layered>> os) {
 	for (auto o : os) addObject(o);
@@ -126,6 +313,48 @@ void FD_ObjectGroup::setCameraSet(std::weak_ptr<FD_CameraSet> set) {
 std::weak_ptr<FD_CameraSet> FD_ObjectGroup::getCameraSet() const {
 	return cameras;
 }
+void FD_ObjectGroup::setSpatialIndex(bool indexed, int cell_size) {
+	drawn.clear();
+	previously_drawn.clear();
+	revision++;
+	if (indexed) {
+		grid = std::make_unique<FD_SpatialGrid>(cell_size);
+		grid_dirty = true;
+	} else {
+		grid.reset();
+		grid_bounds.clear();
+		grid_bounded.clear();
+	}
+}
+bool FD_ObjectGroup::isSpatiallyIndexed() const {
+	return grid != nullptr;
+}
+void FD_ObjectGroup::setStatic(bool is_static, std::shared_ptr<FD_Window> window) {
+	revision++;
+	if (!is_static) {
+		cache.reset();
+		cache_recording.clear();
+		return;
+	}
+	if (cache != nullptr) return;
+	if (window == nullptr) {
+		FD_Handling::error("A static object group needs a window.");
+		return;
+	}
+	cache = std::make_shared<FD_GroupCache>();
+	window->addResizable(cache);
+	cache_dirty = true;
+	cached_camera = nullptr;
+}
+bool FD_ObjectGroup::isStatic() const {
+	return cache != nullptr;
+}
+void FD_ObjectGroup::invalidate() {
+	cache_dirty = true;
+}
+std::shared_ptr<const FD_GroupCache> FD_ObjectGroup::getCache() const {
+	return cache;
+}
 
 int FD_ObjectGroup::getID() const {
 	return id;
@@ -134,21 +363,42 @@ bool FD_ObjectGroup::isVisible() const {
 	return visible;
 }
 Uint8 FD_ObjectGroup::getOpacity() const {
-	double v = opacity->value();
+	double v = opacity.value();
 	if (v > 255) return 255;
 	if (v < 0) return 0;
 	return static_cast<Uint8>(v);
 }
 size_t FD_ObjectGroup::getSize() const {
-	return list.size();
+	return order().size();
+}
+size_t FD_ObjectGroup::getDrawCount() const {
+	if (cache != nullptr) return order().empty() ? 0 : 1;
+	return grid == nullptr ? order().size() : drawn.size();
+}
+size_t FD_ObjectGroup::getDrawIndex(size_t position) const {
+	if (cache != nullptr) return 0;
+	return grid == nullptr ? position : drawn[position];
+}
+size_t FD_ObjectGroup::getDrawPosition(size_t index) const {
+	if (grid == nullptr) return index;
+	// The indices to be drawn ascend, so can be searched
+	auto found{ std::lower_bound(drawn.begin(), drawn.end(), static_cast<Uint32>(index)) };
+	if (found == drawn.end() || *found != index) return drawn.size();
+	return static_cast<size_t>(found - drawn.begin());
+}
+Uint64 FD_ObjectGroup::getRevision() const {
+	// Bring the order up to date first, so pending changes are counted
+	order();
+	return revision;
 }
 bool FD_ObjectGroup::getLayer(size_t index, int& layer) const {
+	const std::vector<Entry>& list{ order() };
 	if (index >= list.size()) return false;
-	layer = list.at(index)->getLayer();
+	layer = list[index].layer;
 	return true;
 }
 
 void FD_ObjectGroup::setVisible(bool visible) {
 	this->visible = visible;
 }
-FD_Tween* FD_ObjectGroup::getTweenOpacity() { return opacity; }
+FD_Tween* FD_ObjectGroup::getTweenOpacity() { return &opacity; }
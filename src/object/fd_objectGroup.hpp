@@ -1,6 +1,9 @@
 #ifndef FD_OBJECT_GROUP_H_
 #define FD_OBJECT_GROUP_H_
 
+#include <map>
+#include <atomic>
+#include <mutex>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -9,6 +12,10 @@
 
 #include "../maths/fd_tween.hpp"
 #include "../display/fd_cameraSet.hpp"
+#include "../display/fd_renderSnapshot.hpp"
+#include "../display/fd_groupCache.hpp"
+#include "../main/fd_jobSystem.hpp"
+#include "fd_spatialGrid.hpp"
 
 /*!
 	@file
@@ -39,14 +46,81 @@ public:
 	//! Destroys the FD_Layered.
 	~FD_Layered();
 
+	//! Fills in the command that draws the object.
+	/*!
+		Without a camera, the destination of a camera bound object is left in
+		the camera's coordinates, for the object group to manipulate along with
+		those of the other objects.
+
+		\param command       The command to fill in.
+		\param alpha         The overall opacity, usually of the overarching object group.
+		\param camera        The camera to be used for relative coordinates, or nullptr.
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
+
+		\return Whether the object should be drawn.
+
+		\sa FD_DrawCommand, FD_Camera::manipulateAll
+	*/
+	virtual bool getDrawCommand(FD_DrawCommand& command, const Uint8 alpha,
+		const std::shared_ptr<const FD_Camera> camera,
+		const double interpolation) const = 0;
 	//! Renders the object.
 	/*!
-		\param renderer The renderer used to draw the object.
-		\param alpha    The overall opacity, usually of the overarching object group.
-		\param camera   The camera to be used for relative coordinates.
+		This draws the command given by getDrawCommand.
+
+		\param renderer      The renderer used to draw the object.
+		\param alpha         The overall opacity, usually of the overarching object group.
+		\param camera        The camera to be used for relative coordinates.
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
 	*/
-	virtual void render(SDL_Renderer* renderer, const Uint8 alpha,
-		const std::shared_ptr<const FD_Camera> camera) const = 0;
+	void render(SDL_Renderer* renderer, const Uint8 alpha,
+		const std::shared_ptr<const FD_Camera> camera,
+		const double interpolation) const;
+	//! Returns the area the object covers, before the camera manipulates it.
+	/*!
+		This is used to index the object spatially, objects without bounds are
+		always drawn. The area should contain the destination rectangle given to
+		FD_Camera::manipulate by getDrawCommand.
+
+		\param bounds The rectangle to write the area to.
+
+		\return Whether the object has bounds.
+
+		\sa FD_ObjectGroup::setSpatialIndex
+	*/
+	virtual bool getCullingBounds(SDL_Rect& bounds) const;
+	//! Returns whether the tweens the object is drawn from have changed since a given time.
+	/*!
+		This is how a static object group knows to redraw its cache, changes
+		made any other way need FD_ObjectGroup::invalidate.
+
+		\param ticks The engine time to check from.
+
+		\return Whether the object may be drawn differently since the time.
+
+		\sa FD_ObjectGroup::setStatic
+	*/
+	virtual bool hasChangedSince(Uint32 ticks) const;
+	//! Records the state of the object at the end of an update cycle.
+	/*!
+		This is called by the object group on every update so that the object
+		can interpolate between its last two updates when rendering.
+	*/
+	virtual void tick();
+	//! Returns whether the object has events waiting for deliverEvents.
+	/*!
+		This is checked right after tick, on the same thread.
+
+		\return Whether the object has events waiting.
+	*/
+	virtual bool hasEvents() const;
+	//! Gives out the events the object held while it ticked.
+	/*!
+		Ticks may be spread across the job system, so anything that calls
+		back into user code is held until the object group calls this, one
+		object at a time, once all of its objects have ticked.
+	*/
+	virtual void deliverEvents();
 
 	//! Changes the layer of the object.
 	/*!
@@ -86,17 +160,82 @@ public:
 };
 
 //! The FD_ObjectGroup class, groups objects for blanket visibility and opacity variability.
+/*!
+	Objects are kept in a bucket per layer, so adding and re-layering an
+	object only appends it to a bucket. Released and re-layered objects are
+	taken out of their buckets together as the group updates. Indices give
+	the objects in layer order, then the order they were added to the layer,
+	and stay valid until the group next changes.
+
+	A static group is drawn from a cache, which is only drawn to again when the
+	group changes.
+
+	\sa setStatic
+*/
 class FD_ObjectGroup : public std::enable_shared_from_this<FD_ObjectGroup> {
 private:
 
+	struct Entry {
+		FD_Layered* object;
+		int layer;
+	};
+
 	const int id;
-	std::vector<std::shared_ptr<FD_Layered>> list{};
+	// The objects of each layer, in the order they were added
+	std::map<int, std::vector<std::shared_ptr<FD_Layered>>> buckets{};
+	std::vector<std::shared_ptr<FD_Layered>> relayered{};
+	// Every object in layer order, rebuilt when the buckets change
+	mutable std::vector<Entry> ordered{};
+	mutable bool reordered{ false };
+	// Incremented whenever the objects to be drawn, or their order, change
+	mutable Uint64 revision{ 0 };
 
 	std::weak_ptr<FD_CameraSet> cameras{ std::weak_ptr<FD_CameraSet>() };
 	
-	FD_Tween* opacity;
+	FD_Tween opacity;
 	bool visible{ true };
 
+	std::unique_ptr<FD_SpatialGrid> grid{ nullptr };
+	bool grid_dirty{ false };
+	std::vector<SDL_Rect> grid_bounds{};
+	std::vector<Uint8> grid_bounded{};
+	std::vector<Uint32> drawn{};
+	std::vector<Uint32> previously_drawn{};
+
+	// The commands of the objects to be drawn, made together by the first record after pre_render
+	mutable std::vector<FD_DrawCommand> staged{};
+	mutable std::vector<Uint8> staged_drawn{};
+	mutable std::vector<Uint32> staged_bound{};
+	mutable std::vector<SDL_Rect> staged_rects{};
+	mutable std::vector<Uint8> staged_visible{};
+	mutable bool staging{ true };
+	mutable bool staged_ok{ false };
+
+	// The cache of a static group, recorded again when the group changes
+	std::shared_ptr<FD_GroupCache> cache{ nullptr };
+	mutable FD_RenderSnapshot cache_recording{};
+	mutable std::atomic<bool> cache_dirty{ false };
+	mutable Uint64 cached_revision{ 0 };
+	mutable bool cache_bound{ false };
+	Uint32 checked_at{ 0 };
+	Uint32 viewed_at{ 0 };
+	const FD_Camera* cached_camera{ nullptr };
+
+	// The indices of the objects with events waiting, found as they tick
+	std::mutex eventful_mutex{};
+	std::vector<Uint32> eventful{};
+	std::vector<FD_Layered*> delivering{};
+
+	static const size_t tick_grain{ 2048 };
+
+	const std::vector<Entry>& order() const;
+	void measure(size_t begin, size_t end);
+	void reindex();
+	void watch(size_t begin, size_t end);
+	void collect(size_t begin, size_t end);
+	bool stage(bool all, Uint8 alpha, const double interpolation) const;
+	size_t getDrawPosition(size_t index) const;
+
 public:
 
 	//! Constructs a FD_ObjectGroup.
@@ -107,22 +246,68 @@ public:
 	//! Destroys the FD_ObjectGroup.
 	~FD_ObjectGroup();
 
-	//! Updates the group, relayering objects and updating cameras.
+	//! Updates the group, relayering objects, ticking objects, delivering their events and, updating cameras.
 	void update();
+	//! Updates the objects of the group, relayering and ticking them.
+	/*!
+		Groups that share no objects can update their objects in parallel.
+
+		\param jobs The job system used to tick large groups in parallel, or nullptr.
+	*/
+	void updateObjects(std::shared_ptr<FD_JobSystem> jobs = nullptr);
+	//! Delivers the events the objects held while they ticked, in layer order.
+	/*!
+		This should be ran after updateObjects, off the job system, as the
+		events may be given to anything.
+
+		\sa FD_Layered::deliverEvents
+	*/
+	void deliverEvents();
+	//! Updates the camera set of the group.
+	/*!
+		Camera sets may be shared between groups, so this should not be ran in parallel.
+	*/
+	void updateCameras();
 
 	//! Prepares the group for a rendering cycle.
+	/*!
+		If the group is spatially indexed, this finds the objects overlapping
+		the culling rectangle of the current camera, which are the only ones drawn.
+		If the group is static, this checks whether its cache is still current.
+
+		\sa setSpatialIndex, setStatic
+	*/
 	void pre_render();
 	//! Renders a specific object.
 	/*!
-		\param index    The index of the object to draw.
-		\param renderer The renderer to use to render the object.
+		\param index         The index of the object to draw.
+		\param renderer      The renderer to use to render the object.
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
 	*/
-	void render(const size_t index, SDL_Renderer* renderer) const;
+	void render(const size_t index, SDL_Renderer* renderer,
+		const double interpolation = 1) const;
 	//! Renders all objects.
 	/*!
-		\param renderer The renderer to use to render the objects.
+		\param renderer      The renderer to use to render the objects.
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
+	*/
+	void render_all(SDL_Renderer* renderer, const double interpolation = 1) const;
+	//! Records the command that draws a specific object to a snapshot.
+	/*!
+		The commands of every object to be drawn are made by the first record
+		after pre_render, with the destinations of camera bound objects
+		manipulated together by FD_Camera::manipulateAll. Each is then moved to
+		the snapshot as its object is recorded.
+
+		A static group records one command that draws its cache, whatever the
+		index, recording its objects to the cache first if they've changed.
+
+		\param index         The index of the object to record.
+		\param snapshot      The snapshot to record to.
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
 	*/
-	void render_all(SDL_Renderer* renderer) const;
+	void record(const size_t index, FD_RenderSnapshot& snapshot,
+		const double interpolation = 1) const;
 
 	//! Adds an object.
 	/*!
@@ -144,6 +329,53 @@ public:
 	void setCameraSet(std::weak_ptr<FD_CameraSet> set);
 	//! Returns the current camera set.
 	std::weak_ptr<FD_CameraSet> getCameraSet() const;
+	//! Sets whether the group indexes its objects in a uniform grid to cull them.
+	/*!
+		Without an index, every object is visited and culled by the camera each
+		frame. With one, the bounds of each object are indexed as the group
+		updates and, only those near the camera's culling rectangle are visited.
+		This suits large worlds where most objects are off camera.
+
+		\param indexed   Whether the group is spatially indexed.
+		\param cell_size The width and height of the cells of the grid.
+
+		\sa FD_Layered::getCullingBounds
+	*/
+	void setSpatialIndex(bool indexed, int cell_size = 256);
+	//! Returns whether the group is spatially indexed.
+	/*!
+		\return Whether the group is spatially indexed.
+	*/
+	bool isSpatiallyIndexed() const;
+	//! Sets whether the group is drawn from a cache that is only drawn to when the group changes.
+	/*!
+		This suits backgrounds and interfaces, which rarely change, as the
+		group then costs one copy per frame instead of a draw per object. The
+		objects are drawn in the layer of the lowest of them, so other groups
+		can't be drawn between them.
+
+		The cache is drawn to again when an object's tweens move, an object is
+		added, released or, re-layered, the camera moves or, the window is
+		resized. Other changes, such as to an image or a colour, need invalidate.
+
+		\param is_static Whether the group is static.
+		\param window    The window the group is drawn to, required to make the group static.
+
+		\sa FD_GroupCache, FD_Layered::hasChangedSince
+	*/
+	void setStatic(bool is_static, std::shared_ptr<FD_Window> window = nullptr);
+	//! Returns whether the group is static.
+	/*!
+		\return Whether the group is static.
+	*/
+	bool isStatic() const;
+	//! Has a static group draw its cache again on the next rendering cycle.
+	void invalidate();
+	//! Returns the cache a static group is drawn from.
+	/*!
+		\return The cache, or nullptr if the group isn't static.
+	*/
+	std::shared_ptr<const FD_GroupCache> getCache() const;
 
 	//! Returns the ID of the group.
 	/*!
@@ -165,6 +397,27 @@ public:
 		\return The number of objects in the group.
 	*/
 	size_t getSize() const;
+	//! Returns the number of objects to be drawn this rendering cycle.
+	/*!
+		\return The number of objects found by pre_render, the size if the group isn't spatially indexed or, one for the cache of a static group with objects.
+	*/
+	size_t getDrawCount() const;
+	//! Returns the index of an object to be drawn this rendering cycle.
+	/*!
+		The indices ascend with the position, so are in layer order.
+
+		\param position The position of the object amongst those to be drawn.
+
+		\return The index of the object.
+	*/
+	size_t getDrawIndex(size_t position) const;
+	//! Returns a number that changes whenever the objects to be drawn, or their order, change.
+	/*!
+		This lets FD_Scene keep the draw order of its groups until one changes.
+
+		\return The revision of the group's draw order.
+	*/
+	Uint64 getRevision() const;
 	//! Returns the layer of a specific object by reference.
 	/*!
 		\param index The index of the object being referred to.
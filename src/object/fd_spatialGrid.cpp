@@ -0,0 +1,125 @@
+#include "fd_spatialGrid.hpp"
+
+#include <algorithm>
+
+FD_SpatialGrid::FD_SpatialGrid(int cell_size) : cell_size{ cell_size > 0 ? cell_size : 1 } {}
+FD_SpatialGrid::~FD_SpatialGrid() {}
+
+Uint64 FD_SpatialGrid::key(int x, int y) {
+	return (static_cast<Uint64>(static_cast<Uint32>(x)) << 32) | static_cast<Uint32>(y);
+}
+int FD_SpatialGrid::cell(int coordinate) const {
+	// Round towards negative infinity so cells don't straddle zero
+	return coordinate >= 0 ? coordinate / cell_size : -((-coordinate - 1) / cell_size) - 1;
+}
+void FD_SpatialGrid::unlist(Uint32 index) {
+	Entry& e{ entries[index] };
+	if (!e.listed) return;
+	e.listed = false;
+	if (!e.bounded) {
+		auto it = std::find(unbounded.begin(), unbounded.end(), index);
+		if (it != unbounded.end()) {
+			*it = unbounded.back();
+			unbounded.pop_back();
+		}
+		return;
+	}
+	for (int x = e.x0; x <= e.x1; x++) {
+		for (int y = e.y0; y <= e.y1; y++) {
+			auto c = cells.find(key(x, y));
+			if (c == cells.end()) continue;
+			std::vector<Uint32>& listed{ c->second };
+			auto it = std::find(listed.begin(), listed.end(), index);
+			if (it != listed.end()) {
+				*it = listed.back();
+				listed.pop_back();
+			}
+			if (listed.empty()) cells.erase(c);
+		}
+	}
+}
+void FD_SpatialGrid::list(Uint32 index) {
+	Entry& e{ entries[index] };
+	e.listed = true;
+	if (!e.bounded) {
+		unbounded.push_back(index);
+		return;
+	}
+	for (int x = e.x0; x <= e.x1; x++) {
+		for (int y = e.y0; y <= e.y1; y++) cells[key(x, y)].push_back(index);
+	}
+}
+
+void FD_SpatialGrid::reset(size_t count) {
+	cells.clear();
+	unbounded.clear();
+	entries.assign(count, Entry());
+	stamps.assign(count, 0);
+	stamp = 0;
+}
+void FD_SpatialGrid::set(Uint32 index, bool bounded, const SDL_Rect& bounds) {
+	if (index >= entries.size()) return;
+	Entry next{};
+	next.listed = true;
+	next.bounded = bounded;
+	if (bounded) {
+		// Include the far edges, as the camera tests them too
+		next.x0 = cell(bounds.x);
+		next.y0 = cell(bounds.y);
+		next.x1 = cell(bounds.x + (bounds.w > 0 ? bounds.w : 0));
+		next.y1 = cell(bounds.y + (bounds.h > 0 ? bounds.h : 0));
+		Sint64 count{ static_cast<Sint64>(next.x1 - next.x0 + 1) * (next.y1 - next.y0 + 1) };
+		if (count > max_cells) next.bounded = false;
+	}
+	const Entry& e{ entries[index] };
+	if (e.listed && e.bounded == next.bounded && (!next.bounded
+		|| (e.x0 == next.x0 && e.y0 == next.y0 && e.x1 == next.x1 && e.y1 == next.y1))) {
+		return;
+	}
+	unlist(index);
+	entries[index] = next;
+	list(index);
+}
+void FD_SpatialGrid::query(const SDL_Rect& area, std::vector<Uint32>& indices) const {
+	indices.clear();
+	// Stamp the indices found so those in many cells are given once
+	if (++stamp == 0) {
+		std::fill(stamps.begin(), stamps.end(), 0);
+		stamp = 1;
+	}
+	for (Uint32 index : unbounded) {
+		stamps[index] = stamp;
+		indices.push_back(index);
+	}
+	int x0{ cell(area.x) }, y0{ cell(area.y) };
+	int x1{ cell(area.x + area.w) }, y1{ cell(area.y + area.h) };
+	Sint64 area_cells{ static_cast<Sint64>(x1 - x0 + 1) * (y1 - y0 + 1) };
+	if (area_cells > static_cast<Sint64>(cells.size())) {
+		// Fewer cells are occupied than covered, so look through those instead
+		for (const auto& c : cells) {
+			int x{ static_cast<int>(static_cast<Uint32>(c.first >> 32)) };
+			int y{ static_cast<int>(static_cast<Uint32>(c.first)) };
+			if (x < x0 || x > x1 || y < y0 || y > y1) continue;
+			for (Uint32 index : c.second) {
+				if (stamps[index] == stamp) continue;
+				stamps[index] = stamp;
+				indices.push_back(index);
+			}
+		}
+	} else {
+		for (int x = x0; x <= x1; x++) {
+			for (int y = y0; y <= y1; y++) {
+				auto c = cells.find(key(x, y));
+				if (c == cells.end()) continue;
+				for (Uint32 index : c->second) {
+					if (stamps[index] == stamp) continue;
+					stamps[index] = stamp;
+					indices.push_back(index);
+				}
+			}
+		}
+	}
+	std::sort(indices.begin(), indices.end());
+}
+
+int FD_SpatialGrid::getCellSize() const { return cell_size; }
@@ -0,0 +1,86 @@
+#ifndef FD_SPATIAL_GRID_H_
+#define FD_SPATIAL_GRID_H_
+
+#include <vector>
+#include <unordered_map>
+
+#include <SDL_rect.h>
+#include <SDL_stdinc.h>
+
+/*!
+	@file
+	@brief The file containing the FD_SpatialGrid class, a uniform grid of rectangles.
+*/
+
+//! The class that buckets indexed rectangles into square cells, so those overlapping an area can be found quickly.
+/*!
+	Each index is listed in every cell its rectangle overlaps and, is only
+	moved between cells when the range of cells it covers changes. Indices
+	without bounds, or whose bounds cover too many cells, are always given
+	by queries.
+
+	\sa FD_ObjectGroup::setSpatialIndex
+*/
+class FD_SpatialGrid {
+private:
+
+	struct Entry {
+		bool listed{ false };
+		bool bounded{ false };
+		int x0{ 0 }, y0{ 0 }, x1{ 0 }, y1{ 0 };
+	};
+
+	const int cell_size;
+	std::vector<Entry> entries{};
+	std::unordered_map<Uint64, std::vector<Uint32>> cells{};
+	std::vector<Uint32> unbounded{};
+
+	mutable std::vector<Uint32> stamps{};
+	mutable Uint32 stamp{ 0 };
+
+	static Uint64 key(int x, int y);
+	int cell(int coordinate) const;
+	void unlist(Uint32 index);
+	void list(Uint32 index);
+
+public:
+
+	//! The most cells an index can be listed in before it is treated as unbounded.
+	static const int max_cells{ 256 };
+
+	//! Constructs a FD_SpatialGrid.
+	/*!
+		\param cell_size The width and height of each cell.
+	*/
+	FD_SpatialGrid(int cell_size);
+	//! Destroys the FD_SpatialGrid.
+	~FD_SpatialGrid();
+
+	//! Removes every index and, sets the number of indices.
+	/*!
+		\param count The number of indices, each starting unlisted.
+	*/
+	void reset(size_t count);
+	//! Sets the bounds of an index, moving it between cells if needed.
+	/*!
+		\param index   The index.
+		\param bounded Whether the index has bounds, if not it is always queried.
+		\param bounds  The bounds of the index.
+	*/
+	void set(Uint32 index, bool bounded, const SDL_Rect& bounds);
+	//! Finds the indices overlapping an area.
+	/*!
+		\param area    The area.
+		\param indices The vector to fill with the indices in ascending order, including those without bounds.
+	*/
+	void query(const SDL_Rect& area, std::vector<Uint32>& indices) const;
+
+	//! Returns the width and height of each cell.
+	/*!
+		\return The width and height of each cell.
+	*/
+	int getCellSize() const;
+
+};
+
+#endif
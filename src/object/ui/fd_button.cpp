@@ -47,11 +47,11 @@ bool FD_Button::isSelected() const {
 bool FD_Button::isEntered() const {
 	return entered;
 }
-FD_Tween* FD_Button::getTweenX() { return x; }
-FD_Tween* FD_Button::getTweenY() { return y; }
-FD_Tween* FD_Button::getTweenWidth() { return w; }
-FD_Tween* FD_Button::getTweenHeight() { return h; }
-FD_Tween* FD_Button::getTweenOpacity() { return opacity; }
+FD_Tween* FD_Button::getTweenX() { return &x; }
+FD_Tween* FD_Button::getTweenY() { return &y; }
+FD_Tween* FD_Button::getTweenWidth() { return &w; }
+FD_Tween* FD_Button::getTweenHeight() { return &h; }
+FD_Tween* FD_Button::getTweenOpacity() { return &opacity; }
 
 // Basic Button Member Functions
 
@@ -123,15 +123,15 @@ FD_BasicButton::FD_BasicButton(const FD_ButtonTemplate& temp,
 	scene->getWindow()->addResizable(pure_image);
 	this->image = pure_image;
 	// Set values
-	this->x->set(static_cast<double>(temp.origin_x) + x);
-	this->y->set(static_cast<double>(temp.origin_y) + y);
+	this->x.set(static_cast<double>(temp.origin_x) + x);
+	this->y.set(static_cast<double>(temp.origin_y) + y);
 	if (temp.width > 0) width = temp.width;
 	if (temp.height > 0) height = temp.height;
-	this->w->set(width);
-	this->h->set(height);
-	this->dstrect = new SDL_Rect();
-	FD_Object::updateBounds(this->dstrect, this->x->value(),
-		this->y->value(), w->value(), h->value(), FD_CENTERED);
+	this->w.set(width);
+	this->h.set(height);
+	this->dstrect = &owned_dstrect;
+	FD_Object::updateBounds(this->dstrect, this->x.value(),
+		this->y.value(), w.value(), h.value(), FD_CENTERED);
 	// Set the code
 	this->return_code = code;
 	// Get the sound
@@ -185,9 +185,9 @@ void FD_BasicButton::update(FD_ButtonActivity activity) {
 		if (auto sfx = sfx_hover.lock()) sfx->play();
 	}
 	// Bounds updating
-	if (x->moved() || y->moved() || w->moved() || h->moved()) {
-		FD_Object::updateBounds(dstrect, x->value(),
-			y->value(), w->value(), h->value(), FD_CENTERED);
+	if (x.moved() || y.moved() || w.moved() || h.moved()) {
+		FD_Object::updateBounds(dstrect, x.value(),
+			y.value(), w.value(), h.value(), FD_CENTERED);
 	}
 }
 bool FD_BasicButton::mouseSelected(FD_ButtonActivity a) const {
@@ -273,15 +273,15 @@ FD_DropdownButton::FD_DropdownButton(const FD_ButtonTemplate& temp,
 			0, temp.z - 1, 1, 1, temp.camera_bound);
 	}
 	// Set dimensions and destination rectangle
-	this->x->set(static_cast<double>(temp.origin_x) + x);
-	this->y->set(static_cast<double>(temp.origin_y) + y);
+	this->x.set(static_cast<double>(temp.origin_x) + x);
+	this->y.set(static_cast<double>(temp.origin_y) + y);
 	if (temp.width > 0) width = temp.width;
 	if (temp.height > 0) height = temp.height;
-	this->w->set(width);
-	this->h->set(height);
-	this->dstrect = new SDL_Rect();
-	FD_Object::updateBounds(dstrect, this->x->value(),
-		this->y->value(), w->value(), h->value(), FD_CENTERED);
+	this->w.set(width);
+	this->h.set(height);
+	this->dstrect = &owned_dstrect;
+	FD_Object::updateBounds(dstrect, this->x.value(),
+		this->y.value(), w.value(), h.value(), FD_CENTERED);
 	// Set some variables
 	if (preselection < codes.size()) {
 		this->option = preselection;
@@ -348,8 +348,8 @@ bool FD_DropdownButton::release() {
 			dropped = true;
 			drop_selection = -1;
 			backing->getTweenOpacity()->move(FD_TWEEN_EASE_OUT, 255, 500);
-			backing->getTweenWidth()->move(FD_TWEEN_EASE_OUT, w->value(), 500);
-			backing->getTweenHeight()->move(FD_TWEEN_EASE_OUT, h->value() * codes.size(), 500);
+			backing->getTweenWidth()->move(FD_TWEEN_EASE_OUT, w.value(), 500);
+			backing->getTweenHeight()->move(FD_TWEEN_EASE_OUT, h.value() * codes.size(), 500);
 			for (auto o : option_elements) {
 				o->getTweenOpacity()->move(FD_TWEEN_EASE_OUT, 255, 500, 500);
 			}
@@ -372,7 +372,7 @@ void FD_DropdownButton::update(FD_ButtonActivity activity) {
 			dropped = false;
 			backing->getTweenOpacity()->move(FD_TWEEN_EASE_OUT, 0, 500, 500);
 			backing->getTweenWidth()->move(FD_TWEEN_EASE_OUT, 0, 500, 500);
-			backing->getTweenHeight()->move(FD_TWEEN_EASE_OUT, h->value(), 500, 500);
+			backing->getTweenHeight()->move(FD_TWEEN_EASE_OUT, h.value(), 500, 500);
 			for (auto o : option_elements) {
 				o->getTweenOpacity()->move(FD_TWEEN_EASE_OUT, 0, 500);
 			}
@@ -387,7 +387,7 @@ void FD_DropdownButton::update(FD_ButtonActivity activity) {
 	// Drop selection
 	if (activity.mouse) configureDropSelection(dropMouseSelected(activity));
 	// Bounds updating
-	if (x->moved() || y->moved() || w->moved() || h->moved()
+	if (x.moved() || y.moved() || w.moved() || h.moved()
 		|| backing->getTweenWidth()->moved()
 		|| backing->getTweenHeight()->moved()
 		|| selection->getTweenY()->moved()) {
@@ -398,18 +398,18 @@ void FD_DropdownButton::update(FD_ButtonActivity activity) {
 
 void FD_DropdownButton::updateElements() {
 	// Background
-	bg->getTweenX()->set(x->value());
-	bg->getTweenY()->set(y->value());
-	bg->setWidth(static_cast<int>(w->value()));
-	bg->setHeight(static_cast<int>(h->value()));
+	bg->getTweenX()->set(x.value());
+	bg->getTweenY()->set(y.value());
+	bg->setWidth(static_cast<int>(w.value()));
+	bg->setHeight(static_cast<int>(h.value()));
 	// Image
 	if (image.expired()) {
-		FD_Object::updateBounds(dstrect, x->value(),
-			y->value(), w->value(), h->value(), FD_CENTERED);
+		FD_Object::updateBounds(dstrect, x.value(),
+			y.value(), w.value(), h.value(), FD_CENTERED);
 	} else {
 		auto i = image.lock();
-		FD_Object::updateBounds(dstrect, x->value(),
-			y->value(), i->getWidth(), i->getHeight(), FD_CENTERED);
+		FD_Object::updateBounds(dstrect, x.value(),
+			y.value(), i->getWidth(), i->getHeight(), FD_CENTERED);
 	}
 	// Backing
 	const SDL_Rect* bgr = bg->getDestinationRect();
@@ -418,16 +418,16 @@ void FD_DropdownButton::updateElements() {
 	backing->getTweenX()->set(bx);
 	backing->getTweenY()->set(by);
 	double ox = bx + backing->getWidth() / 2.0;
-	double oy = by + h->value() / 2.0;
+	double oy = by + h.value() / 2.0;
 	for (auto o : option_elements) {
 		o->getTweenX()->set(ox);
 		o->getTweenY()->set(oy);
-		oy += h->value();
+		oy += h.value();
 	}
 	// Selection
 	selection->getTweenX()->set(backing->getX());
 	selection->getTweenWidth()->set(backing->getWidth());
-	selection->getTweenHeight()->set(h->value());
+	selection->getTweenHeight()->set(h.value());
 }
 
 void FD_DropdownButton::enter() {
@@ -468,7 +468,7 @@ int FD_DropdownButton::dropMouseSelected(FD_ButtonActivity a) const {
 		static_cast<int>(backing->getX()),
 		static_cast<int>(backing->getY()),
 		static_cast<int>(backing->getWidth()),
-		static_cast<int>(h->value()) };
+		static_cast<int>(h.value()) };
 	size_t index{ 0 };
 	while (o_rect.y <= backing->getY() + backing->getHeight()) {
 		if (index >= codes.size()) return -1;
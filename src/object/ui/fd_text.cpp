@@ -12,7 +12,7 @@ FD_Text::FD_Text(SDL_Renderer* renderer,
 	// Set renderer
 	this->renderer = renderer;
 	// Set image
-	this->dstrect = new SDL_Rect();
+	this->dstrect = &owned_dstrect;
 	image = std::make_shared<FD_TextImage>(renderer, font,
 		prefix, "",
 		suffix, colour);
@@ -25,19 +25,19 @@ FD_Text::~FD_Text() {}
 
 void FD_Text::updateBounds() {
 	FD_Object::updateBounds(dstrect,
-		x->value(), y->value(),
-		w->value() * scale_w->value(),
-		h->value() * scale_h->value(), draw_style);
+		x.value(), y.value(),
+		w.value() * scale_w.value(),
+		h.value() * scale_h.value(), draw_style);
 }
 void FD_Text::update() {
-	if (x->moved() || y->moved() || w->moved() || h->moved()) {
+	if (x.moved() || y.moved() || w.moved() || h.moved()) {
 		updateBounds();
 	}
 }
 void FD_Text::changeText(std::string text) {
 	image->changeText(renderer, text);
-	this->w->set(image->getWidth());
-	this->h->set(image->getHeight());
+	this->w.set(image->getWidth());
+	this->h.set(image->getHeight());
 	updateBounds();
 }
 
@@ -55,11 +55,11 @@ std::shared_ptr<FD_Image> FD_Text::getImage() const {
 	return (visible) ? image : nullptr;
 }
 
-FD_Tween* FD_Text::getTweenX() { return x; }
-FD_Tween* FD_Text::getTweenY() { return y; }
-FD_Tween* FD_Text::getTweenScaleX() { return scale_w; }
-FD_Tween* FD_Text::getTweenScaleY() { return scale_h; }
-FD_Tween* FD_Text::getTweenOpacity() { return opacity; }
+FD_Tween* FD_Text::getTweenX() { return &x; }
+FD_Tween* FD_Text::getTweenY() { return &y; }
+FD_Tween* FD_Text::getTweenScaleX() { return &scale_w; }
+FD_Tween* FD_Text::getTweenScaleY() { return &scale_h; }
+FD_Tween* FD_Text::getTweenOpacity() { return &opacity; }
 
 void FD_Text::assimilate(std::shared_ptr<FD_ObjectGroup> group) {
 	group->addObject(shared_from_this());
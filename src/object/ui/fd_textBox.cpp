@@ -10,25 +10,31 @@ FD_TextBox::FD_TextBox(std::weak_ptr<FD_Scene> s,
 	FD_Handling::lock(s, scene, true);
 	// Set values
 	this->draw_style = style;
-	this->line_offset = new FD_Tween(0);
-	this->caret_timer = new FD_Timer();
+	// Blink the caret whilst editing
+	this->caret_timeline = std::make_shared<FD_TweenTimeline>();
+	this->caret_timeline->addDelay(type_temp.caret_blink_delay);
+	this->caret_timeline->setLooping(true);
+	this->caret_timeline->setCompletionCallback([this]() {
+		if (editing && FD_Maths::hasIntersection(dstrect, &caret_rect)) {
+			caret->setVisible(!caret->isVisible());
+		}
+	});
 	// Create the caret
 	this->caret = std::make_shared<FD_Box>(0, 0, 0, 0,
 		z + 1, camera_bound, type_temp.font_colour);
-	this->caret_rect = new SDL_Rect();
-	this->caret_rect->x = x;
-	this->caret_rect->y = y;
-	this->caret_rect->w = 2;
-	this->caret_rect->h = type_temp.font->getSize();
-	this->caret->supplyRect(this->caret_rect);
+	this->caret_rect.x = x;
+	this->caret_rect.y = y;
+	this->caret_rect.w = 2;
+	this->caret_rect.h = type_temp.font->getSize();
+	this->caret->supplyRect(&this->caret_rect);
 	this->caret->setVisible(false);
 	// Set values
-	this->srcrect = new SDL_Rect();
-	FD_Object::updateBounds(this->srcrect, 0, 0, this->w->value(),
-		this->h->value(), FD_TOP_LEFT);
-	this->dstrect = new SDL_Rect();
-	FD_Object::updateBounds(this->dstrect, this->x->value(),
-		this->y->value(), this->w->value(), this->h->value(), draw_style);
+	this->srcrect = &owned_srcrect;
+	FD_Object::updateBounds(this->srcrect, 0, 0, this->w.value(),
+		this->h.value(), FD_TOP_LEFT);
+	this->dstrect = &owned_dstrect;
+	FD_Object::updateBounds(this->dstrect, this->x.value(),
+		this->y.value(), this->w.value(), this->h.value(), draw_style);
 	// Create the pure image
 	this->pure_image = std::make_shared<FD_PureImage>(
 		scene->getWindow()->getRenderer(),
@@ -38,10 +44,9 @@ FD_TextBox::FD_TextBox(std::weak_ptr<FD_Scene> s,
 	this->changeText("");
 }
 FD_TextBox::~FD_TextBox() {
+	// The blink callback refers to this box, so it can't outlive it
+	caret_timeline->stop();
 	this->clearPureElements();
-	delete caret_rect;
-	delete line_offset;
-	delete caret_timer;
 }
 
 void FD_TextBox::clearPureElements() {
@@ -58,31 +63,26 @@ void FD_TextBox::wake() {
 
 void FD_TextBox::update() {
 	// Caret
-	if (editing && FD_Maths::hasIntersection(dstrect, caret_rect)) {
-		if (caret_timer->finished()) {
-			caret->setVisible(!caret->isVisible());
-			caret_timer->start(type_temp.caret_blink_delay);
-		}
-	} else {
+	if (!editing || !FD_Maths::hasIntersection(dstrect, &caret_rect)) {
 		caret->setVisible(false);
 	}
 	// Offset updating
-	if (line_offset->moved()) {
+	if (line_offset.moved()) {
 		if (type_temp.horz_scroll) {
-			this->srcrect->x = static_cast<int>(-line_offset->value());
+			this->srcrect->x = static_cast<int>(-line_offset.value());
 			this->srcrect->y = 0;
-			caret_rect->x = caret_x + dstrect->x + static_cast<int>(line_offset->value());
-			caret_rect->y = caret_y + dstrect->y;
+			caret_rect.x = caret_x + dstrect->x + static_cast<int>(line_offset.value());
+			caret_rect.y = caret_y + dstrect->y;
 		} else {
 			this->srcrect->x = 0;
-			this->srcrect->y = static_cast<int>(-line_offset->value());
-			caret_rect->x = caret_x + dstrect->x;
-			caret_rect->y = caret_y + dstrect->y + static_cast<int>(line_offset->value());
+			this->srcrect->y = static_cast<int>(-line_offset.value());
+			caret_rect.x = caret_x + dstrect->x;
+			caret_rect.y = caret_y + dstrect->y + static_cast<int>(line_offset.value());
 		}
 		this->updateBoxes();
 	}
 	// Bounds updating
-	if (x->moved() || y->moved() || w->moved() || h->moved()) {
+	if (x.moved() || y.moved() || w.moved() || h.moved()) {
 		FD_Object::updateBounds(dstrect);
 	}
 }
@@ -94,7 +94,23 @@ void FD_TextBox::changeText(const std::string text) {
 void FD_TextBox::changeText(const FD_TextInfo info) {
 	text_info = info;
 	caret->setVisible(true);
-	caret_timer->start(type_temp.caret_blink_delay);
+	if (editing) caret_timeline->play();
+	// The text images are remade by the thread that renders, once for any number of changes
+	std::weak_ptr<FD_TextBox> self{ weak_from_this() };
+	if (self.expired()) {
+		this->updateImage();
+		return;
+	}
+	if (image_queued) return;
+	image_queued = true;
+	std::shared_ptr<FD_Scene> s;
+	FD_Handling::lock(scene, s);
+	s->getWindow()->runOnRenderThread([self]() {
+		if (auto box = self.lock()) box->updateImage();
+	});
+}
+void FD_TextBox::updateImage() {
+	image_queued = false;
 	if (type_temp.horz_scroll) {
 		this->updateHorizontalImage();
 	} else {
@@ -352,11 +368,11 @@ void FD_TextBox::updateBoxes() {
 		tr.w = l.w;
 		tr.h = l.h;
 		if (type_temp.horz_scroll) {
-			tr.x = l.x + dstrect->x + static_cast<int>(line_offset->value());
+			tr.x = l.x + dstrect->x + static_cast<int>(line_offset.value());
 			tr.y = l.y + dstrect->y;
 		} else {
 			tr.x = l.x + dstrect->x;
-			tr.y = l.y + dstrect->y + static_cast<int>(line_offset->value());
+			tr.y = l.y + dstrect->y + static_cast<int>(line_offset.value());
 		}
 		if (!FD_Maths::hasIntersection(&tr, dstrect)) {
 			b->setVisible(false);
@@ -388,7 +404,7 @@ void FD_TextBox::updateCaret() {
 }
 void FD_TextBox::updateCaret(size_t pos) {
 	caret->setVisible(true);
-	caret_timer->start(type_temp.caret_blink_delay);
+	if (editing) caret_timeline->play();
 	// Set the new position
 	text_info.caret_pos = pos;
 	// Manage scroll
@@ -413,41 +429,46 @@ void FD_TextBox::updateCaret(size_t pos) {
 	caret_x = capture.x + w;
 	caret_y = capture.y;
 	if (type_temp.horz_scroll) {
-		if (caret_x + line_offset->destination() < 0) {
-			line_offset->move(FD_TWEEN_EASE_OUT, -caret_x, 200);
-		} else if (caret_x + line_offset->destination() > type_temp.box_width) {
-			line_offset->move(FD_TWEEN_EASE_OUT,
+		if (caret_x + line_offset.destination() < 0) {
+			line_offset.move(FD_TWEEN_EASE_OUT, -caret_x, 200);
+		} else if (caret_x + line_offset.destination() > type_temp.box_width) {
+			line_offset.move(FD_TWEEN_EASE_OUT,
 				static_cast<double>(type_temp.box_width) - caret_x, 200);
 		}
 	} else {
-		if (caret_y + line_offset->destination() < 0) {
-			line_offset->move(FD_TWEEN_EASE_OUT, -caret_y, 200);
-		} else if (caret_y + line_offset->destination() + h > type_temp.box_height) {
-			line_offset->move(FD_TWEEN_EASE_OUT,
+		if (caret_y + line_offset.destination() < 0) {
+			line_offset.move(FD_TWEEN_EASE_OUT, -caret_y, 200);
+		} else if (caret_y + line_offset.destination() + h > type_temp.box_height) {
+			line_offset.move(FD_TWEEN_EASE_OUT,
 				static_cast<double>(type_temp.box_height) - caret_y - h, 200);
 		}
 		Uint32 final_y{ 0 };
 		if (lines.size() > 0) final_y = lines.back().y + lines.back().h;
-		if (-line_offset->destination() + srcrect->h > final_y) {
+		if (-line_offset.destination() + srcrect->h > final_y) {
 			double push_up{ static_cast<double>(srcrect->h - final_y) };
 			if (push_up > 0) push_up = 0;
-			line_offset->move(FD_TWEEN_EASE_OUT, push_up, 200);
+			line_offset.move(FD_TWEEN_EASE_OUT, push_up, 200);
 		}
 	}
 	// Position the caret
 	if (type_temp.horz_scroll) {
-		caret_rect->x = caret_x + dstrect->x + static_cast<int>(line_offset->value());
-		caret_rect->y = caret_y + dstrect->y;
+		caret_rect.x = caret_x + dstrect->x + static_cast<int>(line_offset.value());
+		caret_rect.y = caret_y + dstrect->y;
 	} else {
-		caret_rect->x = caret_x + dstrect->x;
-		caret_rect->y = caret_y + dstrect->y + static_cast<int>(line_offset->value());
+		caret_rect.x = caret_x + dstrect->x;
+		caret_rect.y = caret_y + dstrect->y + static_cast<int>(line_offset.value());
 	}
 	this->update();
 }
 
 void FD_TextBox::setEditing(bool edit) {
+	if (edit && !editing) caret_timeline->play();
 	this->editing = edit;
-	if (!edit) for (auto b : boxes) b->setVisible(false);
+	if (!edit) {
+		// Only blink the caret whilst editing
+		caret_timeline->stop();
+		for (auto b : boxes) b->setVisible(false);
+	}
 }
 
 std::shared_ptr<FD_Image> FD_TextBox::getImage() const {
@@ -461,10 +482,10 @@ FD_TextInfo FD_TextBox::getTextInfo() const {
 }
 
 FD_Tween* FD_TextBox::getTweenX() {
-	return x;
+	return &x;
 }
 FD_Tween* FD_TextBox::getTweenY() {
-	return y;
+	return &y;
 }
 
 void FD_TextBox::assimilate(std::shared_ptr<FD_ObjectGroup> group) {
@@ -2,7 +2,7 @@
 #define FD_TEXTBOX_HPP_
 
 #include "../fd_object.hpp"
-#include "../../maths/fd_timer.hpp"
+#include "../../maths/fd_tweenTimeline.hpp"
 #include "../../main/fd_handling.hpp"
 #include "../../display/fd_scene.hpp"
 
@@ -66,17 +66,19 @@ private:
 	std::vector<std::shared_ptr<FD_Box>> boxes{ };
 
 	int caret_x{ 0 }, caret_y{ 0 };
-	SDL_Rect* caret_rect;
+	SDL_Rect caret_rect{ };
 	std::shared_ptr<FD_Box> caret;
 
-	FD_Timer* caret_timer;
-	FD_Tween* line_offset;
+	std::shared_ptr<FD_TweenTimeline> caret_timeline;
+	FD_Tween line_offset{ 0 };
 	std::vector<LineSection> lines{ };
 	const FD_TextTemplate type_temp;
 
 	FD_TextInfo text_info;
 	bool editing{ false };
+	bool image_queued{ false };
 
+	void updateImage();
 	void updateHorizontalImage();
 	void updateVerticalImage();
 
@@ -116,7 +118,12 @@ public:
 	void changeText(const std::string text);
 	//! Changes the box's text.
 	/*!
+		The text is drawn by the thread that renders, so when called on a
+		separate update thread the box changes before the next frame.
+
 		\param info The new text information.
+
+		\sa FD_Window::runOnRenderThread
 	*/
 	void changeText(const FD_TextInfo info);
 	//! Updates the caret's position.
@@ -61,15 +61,15 @@ FD_TextField::FD_TextField(const FD_ButtonTemplate& temp,
 	input->addKeyMap(FD_MAP_PRESSED, SDLK_a, SELECT_ALL);
 	input->addKeyMap(FD_MAP_PRESSED, SDLK_v, PASTE);
 	// Set values
-	this->x->set(static_cast<double>(temp.origin_x) + x);
-	this->y->set(static_cast<double>(temp.origin_y) + y);
+	this->x.set(static_cast<double>(temp.origin_x) + x);
+	this->y.set(static_cast<double>(temp.origin_y) + y);
 	if (temp.width > 0) width = temp.width;
 	if (temp.height > 0) height = temp.height;
-	this->w->set(width);
-	this->h->set(height);
-	this->dstrect = new SDL_Rect();
-	FD_Object::updateBounds(this->dstrect, this->x->value(),
-		this->y->value(), w->value(), h->value(), FD_CENTERED);
+	this->w.set(width);
+	this->h.set(height);
+	this->dstrect = &owned_dstrect;
+	FD_Object::updateBounds(this->dstrect, this->x.value(),
+		this->y.value(), w.value(), h.value(), FD_CENTERED);
 	// Set the code
 	this->return_code = code;
 	// Get the sound
@@ -147,11 +147,11 @@ void FD_TextField::update(FD_ButtonActivity activity) {
 	}
 	if (!focus) input->empty();
 	// Bounds updating
-	if (x->moved() || y->moved() || w->moved() || h->moved()) {
-		FD_Object::updateBounds(dstrect, x->value(),
-			y->value(), w->value(), h->value(), FD_CENTERED);
-		text_box->getTweenX()->set(x->value());
-		text_box->getTweenY()->set(y->value());
+	if (x.moved() || y.moved() || w.moved() || h.moved()) {
+		FD_Object::updateBounds(dstrect, x.value(),
+			y.value(), w.value(), h.value(), FD_CENTERED);
+		text_box->getTweenX()->set(x.value());
+		text_box->getTweenY()->set(y.value());
 	}
 	// Text
 	text_box->update();
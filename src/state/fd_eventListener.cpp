@@ -1,6 +1,6 @@
 #include "fd_eventListener.hpp"
 
-FD_EventListener::FD_EventListener() {}
+FD_EventListener::FD_EventListener(const std::vector<Uint32> types) : types{ types } {}
 FD_EventListener::~FD_EventListener() {}
 
 void FD_EventListener::pushEvent(const SDL_Event* e) {
@@ -25,4 +25,6 @@ bool FD_EventListener::pullEvent(SDL_Event& e) {
 
 void FD_EventListener::clear() {
 	queue.clear();
-}
\ No newline at end of file
+}
+
+const std::vector<Uint32>& FD_EventListener::getTypes() const { return types; }
\ No newline at end of file
@@ -10,17 +10,25 @@
 	@brief The file containing the FD_EventListener.
 */
 
-//! The FD_EventListener, allows any class to listen to all SDL_Events.
+//! The FD_EventListener, allows any class to listen to SDL_Events.
+/*!
+	A listener can be limited to certain event types, in which case
+	FD_StateManager only gives it events of those types.
+*/
 class FD_EventListener {
 private:
 
 	bool accepting{ true };
 	std::vector<SDL_Event> queue{};
+	const std::vector<Uint32> types;
 
 public:
 
 	//! Constructs a FD_EventListener.
-	FD_EventListener();
+	/*!
+		\param types The event types to listen to, or none to listen to every event.
+	*/
+	FD_EventListener(const std::vector<Uint32> types = {});
 	//! Destroys the FD_EventListener.
 	~FD_EventListener();
 
@@ -47,6 +55,12 @@ public:
 	//! Clears the event queue.
 	virtual void clear();
 
+	//! Returns the event types the listener listens to.
+	/*!
+		\return The event types, empty if the listener listens to every event.
+	*/
+	const std::vector<Uint32>& getTypes() const;
+
 };
 
 #endif
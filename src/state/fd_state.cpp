@@ -35,3 +35,4 @@ bool FD_State::hasClosed() {
 }
 
 int FD_State::getID() const { return id; }
+std::shared_ptr<FD_ObjectArena> FD_State::getArena() const { return arena; }
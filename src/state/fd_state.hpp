@@ -5,6 +5,7 @@
 
 #include "../main/fd_handling.hpp"
 #include "../display/fd_scene.hpp"
+#include "../object/fd_objectArena.hpp"
 
 /*!
 	@file
@@ -33,6 +34,11 @@ protected:
 	bool closed{ false };
 	//! The scene used by this state.
 	std::weak_ptr<FD_Scene> scene;
+	//! The arena for the state's objects, its unused memory is released as the state sleeps.
+	/*!
+		\sa getArena
+	*/
+	std::shared_ptr<FD_ObjectArena> arena{ std::make_shared<FD_ObjectArena>() };
 
 	//! Returns a new input list ID.
 	int getInputList(std::weak_ptr<FD_Scene> scene);
@@ -88,6 +94,11 @@ public:
 		\return The ID of the state.
 	*/
 	int getID() const;
+	//! Returns the arena for the state's objects, to be given to a FD_Factory.
+	/*!
+		\return The arena for the state's objects.
+	*/
+	std::shared_ptr<FD_ObjectArena> getArena() const;
 
 };
 
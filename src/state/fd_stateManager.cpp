@@ -19,7 +19,14 @@ void FD_StateManager::logState(std::weak_ptr<FD_State> s) {
 }
 
 void FD_StateManager::logEventListener(std::weak_ptr<FD_EventListener> el) {
-	this->event_list.push_back(el);
+	std::shared_ptr<FD_EventListener> listener;
+	FD_Handling::lock(el, listener, true);
+	// Listeners to particular types are indexed by type
+	if (listener->getTypes().empty()) {
+		this->event_list.push_back(el);
+	} else {
+		for (Uint32 type : listener->getTypes()) event_table[type].push_back(el);
+	}
 }
 
 void FD_StateManager::setState(int id) {
@@ -27,6 +34,8 @@ void FD_StateManager::setState(int id) {
 		std::shared_ptr<FD_State> state;
 		FD_Handling::lock(states.at(currentState), state, true);
 		state->sleep();
+		// Give back the memory of the objects the state let go of
+		state->getArena()->release();
 	}
 	currentState = id;
 	if (currentState != FD_State::INVALID_STATE) {
@@ -55,24 +64,65 @@ void FD_StateManager::update() {
 	scene->update();
 }
 
-void FD_StateManager::render() {
+void FD_StateManager::render(double interpolation) {
 	if (currentState == FD_State::INVALID_STATE) return;
 	std::shared_ptr<FD_Scene> scene;
 	FD_Handling::lock(this->scene, scene, true);
-	scene->render();
+	scene->render(interpolation);
+}
+
+void FD_StateManager::publish() {
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(this->scene, scene, true);
+	scene->publish();
+}
+
+void FD_StateManager::stopPublishing() {
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(this->scene, scene, true);
+	scene->stopPublishing();
 }
 
 void FD_StateManager::pushEvent(const SDL_Event* e) {
+	pushEvents(e, 1);
+}
+void FD_StateManager::pushEvents(const SDL_Event* events, size_t count) {
 	std::shared_ptr<FD_Scene> scene;
 	FD_Handling::lock(this->scene, scene, true);
-	scene->pushEvent(e);
-	auto it = event_list.begin();
-	while (it != event_list.end()) {
+	for (size_t i = 0; i < count; i++) {
+		const SDL_Event* e{ &events[i] };
+		scene->pushEvent(e);
+		if (!event_table.empty()) {
+			auto listeners = event_table.find(e->type);
+			if (listeners != event_table.end()) notify(listeners->second, e);
+		}
+		if (!event_list.empty()) notify(event_list, e);
+	}
+}
+void FD_StateManager::pushWindowEvent(const SDL_Event* e) {
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(this->scene, scene, true);
+	scene->pushWindowEvent(e);
+}
+bool FD_StateManager::hasRenderTasks() {
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(this->scene, scene, true);
+	return scene->hasRenderTasks();
+}
+void FD_StateManager::runRenderTasks() {
+	std::shared_ptr<FD_Scene> scene;
+	FD_Handling::lock(this->scene, scene, true);
+	scene->runRenderTasks();
+}
+void FD_StateManager::notify(std::vector<std::weak_ptr<FD_EventListener>>& listeners,
+	const SDL_Event* e) {
+	auto it = listeners.begin();
+	while (it != listeners.end()) {
 		if (auto el = (*it).lock()) {
 			el->pushEvent(e);
 			it++;
 		} else {
-			it = event_list.erase(it);
+			it = listeners.erase(it);
 		}
 	}
 }
@@ -1,7 +1,9 @@
 #ifndef FD_STATE_MANAGER_H_
 #define FD_STATE_MANAGER_H_
 
+#include <atomic>
 #include <memory>
+#include <unordered_map>
 
 #include "fd_state.hpp"
 #include "fd_eventListener.hpp"
@@ -20,9 +22,12 @@ private:
 
 	std::weak_ptr<FD_Scene> scene;
 
-	int currentState{ FD_State::INVALID_STATE };
+	std::atomic<int> currentState{ FD_State::INVALID_STATE };
 	std::vector<std::weak_ptr<FD_State>> states{};
 	std::vector<std::weak_ptr<FD_EventListener>> event_list{};
+	std::unordered_map<Uint32, std::vector<std::weak_ptr<FD_EventListener>>> event_table{};
+
+	void notify(std::vector<std::weak_ptr<FD_EventListener>>& listeners, const SDL_Event* e);
 
 public:
 
@@ -37,17 +42,60 @@ public:
 	//! Adds a state to the manager.
 	void logState(std::weak_ptr<FD_State> state);
 	//! Adds an event listener to the manager.
+	/*!
+		The listener is only given the event types it listens to.
+
+		\param el The listener to add.
+
+		\sa FD_EventListener::getTypes
+	*/
 	void logEventListener(std::weak_ptr<FD_EventListener> el);
 
 	//! Updates the states and the scene.
 	void update() override;
 	//! Renders the scene.
-	void render() override;
+	/*!
+		\param interpolation How far the loop is between the last update and the next, from 0 to 1.
+	*/
+	void render(double interpolation) override;
+	//! Publishes the scene for rendering.
+	/*!
+		\sa FD_Scene::publish
+	*/
+	void publish() override;
+	//! Stops publishing the scene for rendering.
+	/*!
+		\sa FD_Scene::stopPublishing
+	*/
+	void stopPublishing() override;
 	//! Provides an event to the manager to process.
 	/*!
 		\param e The event to process.
 	*/
 	void pushEvent(const SDL_Event* e) override;
+	//! Provides a batch of events to the manager to process.
+	/*!
+		\param events The events to process, in order.
+		\param count  The number of events.
+	*/
+	void pushEvents(const SDL_Event* events, size_t count) override;
+	//! Provides a window event to the scene, on the thread that renders.
+	/*!
+		\param e The window event.
+
+		\sa FD_Scene::pushWindowEvent
+	*/
+	void pushWindowEvent(const SDL_Event* e) override;
+	//! Returns whether the scene has tasks queued for the thread that renders.
+	/*!
+		\return Whether runRenderTasks has anything to run.
+	*/
+	bool hasRenderTasks() override;
+	//! Runs the tasks the scene has queued for the thread that renders.
+	/*!
+		\sa FD_Scene::runRenderTasks
+	*/
+	void runRenderTasks() override;
 
 	//! Changes the state of the manager.
 	/*!